@@ -608,6 +608,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/paths/AccountCurrencies.cpp
   src/ripple/app/paths/Credit.cpp
   src/ripple/app/paths/Flow.cpp
+  src/ripple/app/paths/PathDependencies.cpp
   src/ripple/app/paths/PathRequest.cpp
   src/ripple/app/paths/PathRequests.cpp
   src/ripple/app/paths/Pathfinder.cpp
@@ -751,6 +752,7 @@ target_sources (rippled PRIVATE
   src/ripple/overlay/impl/PeerReservationTable.cpp
   src/ripple/overlay/impl/PeerSet.cpp
   src/ripple/overlay/impl/ProtocolVersion.cpp
+  src/ripple/overlay/impl/SendQueue.cpp
   src/ripple/overlay/impl/TrafficCount.cpp
   src/ripple/overlay/impl/TxMetrics.cpp
   #[===============================[
@@ -904,6 +906,7 @@ if (tests)
     src/test/app/Offer_test.cpp
     src/test/app/Oracle_test.cpp
     src/test/app/OversizeMeta_test.cpp
+    src/test/app/PathDependencies_test.cpp
     src/test/app/Path_test.cpp
     src/test/app/PayChan_test.cpp
     src/test/app/PayStrand_test.cpp
@@ -1103,6 +1106,7 @@ if (tests)
     src/test/overlay/reduce_relay_test.cpp
     src/test/overlay/handshake_test.cpp
     src/test/overlay/tx_reduce_relay_test.cpp
+    src/test/overlay/send_queue_test.cpp
     #[===============================[
        test sources:
          subdir: peerfinder
@@ -1123,6 +1127,7 @@ if (tests)
     src/test/protocol/InnerObjectFormats_test.cpp
     src/test/protocol/Issue_test.cpp
     src/test/protocol/Hooks_test.cpp
+    src/test/protocol/digest_test.cpp
     src/test/protocol/Memo_test.cpp
     src/test/protocol/MultiApiJson_test.cpp
     src/test/protocol/PublicKey_test.cpp
@@ -1202,6 +1207,7 @@ if (tests)
          subdir: shamap
     #]===============================]
     src/test/shamap/FetchPack_test.cpp
+    src/test/shamap/SHAMapHashing_test.cpp
     src/test/shamap/SHAMapSync_test.cpp
     src/test/shamap/SHAMap_test.cpp
     #[===============================[
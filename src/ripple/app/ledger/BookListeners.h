@@ -54,13 +54,15 @@ public:
         Uses havePublished to prevent sending duplicate transactions to clients
         that have subscribed to multiple books.
 
-        @param jvObj JSON transaction data to publish
+        @param message JSON transaction data to publish
         @param havePublished InfoSub sequence numbers that have already
                              published this transaction.
 
     */
     void
-    publish(MultiApiJson const& jvObj, hash_set<std::uint64_t>& havePublished);
+    publish(
+        PublishedJson const& message,
+        hash_set<std::uint64_t>& havePublished);
 
 private:
     std::recursive_mutex mLock;
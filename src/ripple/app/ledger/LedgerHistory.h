@@ -26,6 +26,7 @@
 #include <ripple/beast/insight/Event.h>
 #include <ripple/protocol/RippleLedgerHash.h>
 
+#include <mutex>
 #include <optional>
 
 namespace ripple {
@@ -148,9 +149,15 @@ private:
     using ConsensusValidated = TaggedCache<LedgerIndex, cv_entry>;
     ConsensusValidated m_consensus_validated;
 
+    // Protects the contents of the entries in m_consensus_validated
+    std::mutex consensusValidatedMutex_;
+
     // Maps ledger indexes to the corresponding hash.
     std::map<LedgerIndex, LedgerHash> mLedgersByIndex;  // validated ledgers
 
+    // Protects mLedgersByIndex
+    std::mutex ledgersByIndexMutex_;
+
     beast::Journal j_;
 };
 
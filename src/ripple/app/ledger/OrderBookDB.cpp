@@ -159,6 +159,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
         std::lock_guard sl(mLock);
         allBooks_.swap(allBooks);
         xrpBooks_.swap(xrpBooks);
+        ++generation_;
     }
 
     app_.getLedgerMaster().newOrderBookDB();
@@ -171,7 +172,8 @@ OrderBookDB::addOrderBook(Book const& book)
 
     std::lock_guard sl(mLock);
 
-    allBooks_[book.in].insert(book.out);
+    if (allBooks_[book.in].insert(book.out).second)
+        ++generation_;
 
     if (toXRP)
         xrpBooks_.insert(book.in);
@@ -260,6 +262,7 @@ OrderBookDB::processTxn(
     // entries for the same book, or if it touches multiple books and a
     // single client has subscribed to those books.
     hash_set<std::uint64_t> havePublished;
+    PublishedJson const message{jvObj};
 
     for (auto const& node : alTx.getMeta().getNodes())
     {
@@ -277,7 +280,7 @@ OrderBookDB::processTxn(
                             {data->getFieldAmount(sfTakerGets).issue(),
                              data->getFieldAmount(sfTakerPays).issue()});
                         if (listeners)
-                            listeners->publish(jvObj, havePublished);
+                            listeners->publish(message, havePublished);
                     }
                 };
 
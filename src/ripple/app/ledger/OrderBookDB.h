@@ -25,6 +25,7 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/protocol/MultiApiJson.h>
 
+#include <atomic>
 #include <mutex>
 
 namespace ripple {
@@ -55,6 +56,13 @@ public:
     bool
     isBookToXRP(Issue const&);
 
+    /** A number which changes whenever the set of books does. */
+    std::uint64_t
+    generation() const
+    {
+        return generation_.load();
+    }
+
     BookListeners::pointer
     getBookListeners(Book const&);
     BookListeners::pointer
@@ -78,6 +86,8 @@ private:
 
     std::recursive_mutex mLock;
 
+    std::atomic<std::uint64_t> generation_{0};
+
     using BookToListenersMap = hash_map<Book, BookListeners::pointer>;
 
     BookToListenersMap mListeners;
@@ -23,9 +23,16 @@
 #include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/validity.h>
 #include <ripple/protocol/Feature.h>
 
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+
 namespace ripple {
 
 /* Generic buildLedgerImpl that dispatches to ApplyTxs invocable with signature
@@ -67,7 +74,7 @@ buildLedgerImpl(
         // Write the final version of all modified SHAMap
         // nodes to the node store to preserve the new LCL
 
-        int const asf = built->stateMap().flushDirty(hotACCOUNT_NODE);
+        int const asf = built->stateMap().flushDirty(hotACCOUNT_NODE, true);
         int const tmf = built->txMap().flushDirty(hotTRANSACTION_NODE);
         JLOG(j.debug()) << "Flushed " << asf << " accounts and " << tmf
                         << " transaction nodes";
@@ -83,6 +90,82 @@ buildLedgerImpl(
     return built;
 }
 
+/** Check the signatures of transactions that are about to be applied.
+
+    Unlike the rest of transaction application, checking a signature does not
+    depend on the ledger state, so the transactions are split among several
+    threads here. The results are recorded in the HashRouter, where preflight
+    finds them when the transactions are then applied in canonical order.
+
+    Transactions whose signatures are already cached, which is most of them
+    when this server relayed or proposed the set, are skipped before deciding
+    whether enough work is left to be worth starting the threads.
+*/
+static void
+checkSignatures(
+    Application& app,
+    Rules const& rules,
+    std::vector<std::shared_ptr<STTx const>> txs,
+    beast::Journal j)
+{
+    // With fewer transactions per thread, starting the threads costs more
+    // than it saves.
+    std::size_t constexpr minPerThread = 32;
+
+    auto& router = app.getHashRouter();
+    txs.erase(
+        std::remove_if(
+            txs.begin(),
+            txs.end(),
+            [&router](auto const& tx) {
+                return isSignatureCached(router, tx->getTransactionID());
+            }),
+        txs.end());
+
+    auto const threads = std::min<std::size_t>(
+        std::thread::hardware_concurrency(), txs.size() / minPerThread);
+    if (threads < 2)
+        return;
+
+    std::atomic<std::size_t> next = 0;
+    auto check = [&]() {
+        for (auto i = next++; i < txs.size(); i = next++)
+        {
+            try
+            {
+                checkValidity(router, *txs[i], rules, app.config());
+            }
+            catch (std::exception const& ex)
+            {
+                // Preflight checks the transaction again and deals with it
+                JLOG(j.debug()) << "Exception checking signature of "
+                                << txs[i]->getTransactionID() << ": "
+                                << ex.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i)
+    {
+        try
+        {
+            workers.emplace_back(check);
+        }
+        catch (std::system_error const& e)
+        {
+            JLOG(j.warn()) << "Unable to start signature thread: " << e.what();
+            break;
+        }
+    }
+
+    check();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
 /** Apply a set of consensus transactions to a ledger.
 
   @param app Handle to application
@@ -200,6 +283,14 @@ buildLedger(
             JLOG(j.debug())
                 << "Attempting to apply " << txns.size() << " transactions";
 
+            {
+                std::vector<std::shared_ptr<STTx const>> txs;
+                txs.reserve(txns.size());
+                for (auto const& item : txns)
+                    txs.push_back(item.second);
+                checkSignatures(app, accum.rules(), std::move(txs), j);
+            }
+
             auto const applied =
                 applyTransactions(app, built, txns, failedTxns, accum, j);
 
@@ -232,6 +323,14 @@ buildLedger(
         app,
         j,
         [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
+            {
+                std::vector<std::shared_ptr<STTx const>> txs;
+                txs.reserve(replayData.orderedTxns().size());
+                for (auto const& tx : replayData.orderedTxns())
+                    txs.push_back(tx.second);
+                checkSignatures(app, accum.rules(), std::move(txs), j);
+            }
+
             for (auto& tx : replayData.orderedTxns())
                 applyTransaction(app, accum, *tx.second, false, applyFlags, j);
         });
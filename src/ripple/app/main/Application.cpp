@@ -2224,7 +2224,7 @@ ApplicationImp::loadLedgerFromFile(std::string const& name)
             }
         }
 
-        loadLedger->stateMap().flushDirty(hotACCOUNT_NODE);
+        loadLedger->stateMap().flushDirty(hotACCOUNT_NODE, true);
 
         assert(
             loadLedger->info().seq < XRP_LEDGER_EARLIEST_FEES ||
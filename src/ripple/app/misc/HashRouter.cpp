@@ -21,30 +21,42 @@
 
 namespace ripple {
 
+HashRouter::HashRouter(
+    Stopwatch& clock,
+    std::chrono::seconds entryHoldTimeInSeconds)
+    : holdTime_(entryHoldTimeInSeconds)
+{
+    for (auto& shard : shards_)
+        shard = std::make_unique<Shard>(clock);
+}
+
 auto
-HashRouter::emplace(uint256 const& key) -> std::pair<Entry&, bool>
+HashRouter::emplace(Shard& shard, uint256 const& key)
+    -> std::pair<Entry&, bool>
 {
-    auto iter = suppressionMap_.find(key);
+    auto& suppressionMap = shard.suppressionMap;
+    auto iter = suppressionMap.find(key);
 
-    if (iter != suppressionMap_.end())
+    if (iter != suppressionMap.end())
     {
-        suppressionMap_.touch(iter);
+        suppressionMap.touch(iter);
         return std::make_pair(std::ref(iter->second), false);
     }
 
-    // See if any supressions need to be expired
-    expire(suppressionMap_, holdTime_);
+    // See if any supressions in this shard need to be expired
+    expire(suppressionMap, holdTime_);
 
     return std::make_pair(
-        std::ref(suppressionMap_.emplace(key, Entry()).first->second), true);
+        std::ref(suppressionMap.emplace(key, Entry()).first->second), true);
 }
 
 void
 HashRouter::addSuppression(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    std::lock_guard lock(shard.mutex);
 
-    emplace(key);
+    emplace(shard, key);
 }
 
 bool
@@ -56,9 +68,10 @@ HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer)
 std::pair<bool, std::optional<Stopwatch::time_point>>
 HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(shard, key);
     result.first.addPeer(peer);
     return {result.second, result.first.relayed()};
 }
@@ -66,9 +79,10 @@ HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 bool
 HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto [s, created] = emplace(key);
+    auto [s, created] = emplace(shard, key);
     s.addPeer(peer);
     flags = s.getFlags();
     return created;
@@ -81,21 +95,23 @@ HashRouter::shouldProcess(
     int& flags,
     std::chrono::seconds tx_interval)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(shard, key);
     auto& s = result.first;
     s.addPeer(peer);
     flags = s.getFlags();
-    return s.shouldProcess(suppressionMap_.clock().now(), tx_interval);
+    return s.shouldProcess(shard.suppressionMap.clock().now(), tx_interval);
 }
 
 int
 HashRouter::getFlags(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    std::lock_guard lock(shard.mutex);
 
-    return emplace(key).first.getFlags();
+    return emplace(shard, key).first.getFlags();
 }
 
 bool
@@ -103,9 +119,10 @@ HashRouter::setFlags(uint256 const& key, int flags)
 {
     assert(flags != 0);
 
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(shard, key).first;
 
     if ((s.getFlags() & flags) == flags)
         return false;
@@ -118,11 +135,12 @@ auto
 HashRouter::shouldRelay(uint256 const& key)
     -> std::optional<std::set<PeerShortID>>
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = this->shard(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(shard, key).first;
 
-    if (!s.shouldRelay(suppressionMap_.clock().now(), holdTime_))
+    if (!s.shouldRelay(shard.suppressionMap.clock().now(), holdTime_))
         return {};
 
     return s.releasePeerSet();
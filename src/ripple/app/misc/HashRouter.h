@@ -26,6 +26,9 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/container/aged_unordered_map.h>
 
+#include <array>
+#include <memory>
+#include <mutex>
 #include <optional>
 
 namespace ripple {
@@ -49,6 +52,11 @@ namespace ripple {
     This table keeps track of which hashes have been received by which peers.
     It is used to manage the routing and broadcasting of messages in the peer
     to peer overlay.
+
+    The table is split into shards selected by the hash, each with its own
+    lock and its own aging, so that peer threads handling unrelated messages
+    do not contend with each other. Inserting a hash expires old entries of
+    its shard only.
 */
 class HashRouter
 {
@@ -143,10 +151,7 @@ public:
         return 300s;
     }
 
-    HashRouter(Stopwatch& clock, std::chrono::seconds entryHoldTimeInSeconds)
-        : suppressionMap_(clock), holdTime_(entryHoldTimeInSeconds)
-    {
-    }
+    HashRouter(Stopwatch& clock, std::chrono::seconds entryHoldTimeInSeconds);
 
     HashRouter&
     operator=(HashRouter const&) = delete;
@@ -206,19 +211,38 @@ public:
     shouldRelay(uint256 const& key);
 
 private:
-    // pair.second indicates whether the entry was created
-    std::pair<Entry&, bool>
-    emplace(uint256 const&);
+    static constexpr std::size_t shardCount = 32;
+
+    struct alignas(64) Shard
+    {
+        explicit Shard(Stopwatch& clock) : suppressionMap(clock)
+        {
+        }
 
-    std::mutex mutable mutex_;
+        std::mutex mutex;
+
+        // Stores the suppressed hashes of this shard and their expiration time
+        beast::aged_unordered_map<
+            uint256,
+            Entry,
+            Stopwatch::clock_type,
+            hardened_hash<strong_hash>>
+            suppressionMap;
+    };
+
+    Shard&
+    shard(uint256 const& key)
+    {
+        // The keys are themselves hashes, so any byte will do.
+        return *shards_[*key.begin() % shardCount];
+    }
+
+    // pair.second indicates whether the entry was created.
+    // The shard's mutex must be held.
+    std::pair<Entry&, bool>
+    emplace(Shard& shard, uint256 const&);
 
-    // Stores all suppressed hashes and their expiration time
-    beast::aged_unordered_map<
-        uint256,
-        Entry,
-        Stopwatch::clock_type,
-        hardened_hash<strong_hash>>
-        suppressionMap_;
+    std::array<std::unique_ptr<Shard>, shardCount> shards_;
 
     std::chrono::seconds const holdTime_;
 };
@@ -1980,12 +1980,14 @@ NetworkOPsImp::pubManifest(Manifest const& mo)
             jvObj[jss::domain] = mo.domain;
         jvObj[jss::manifest] = strHex(mo.serialized);
 
+        PublishedJson const message{jvObj};
+
         for (auto i = mStreamMaps[sManifests].begin();
              i != mStreamMaps[sManifests].end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->publish(message);
                 ++i;
             }
             else
@@ -2083,6 +2085,8 @@ NetworkOPsImp::pubServer()
 
         mLastFeeSummary = f;
 
+        PublishedJson const message{jvObj};
+
         for (auto i = mStreamMaps[sServer].begin();
              i != mStreamMaps[sServer].end();)
         {
@@ -2093,7 +2097,7 @@ NetworkOPsImp::pubServer()
             //             sending of JSON data.
             if (p)
             {
-                p->send(jvObj, true);
+                p->publish(message);
                 ++i;
             }
             else
@@ -2116,11 +2120,13 @@ NetworkOPsImp::pubConsensus(ConsensusPhase phase)
         jvObj[jss::type] = "consensusPhase";
         jvObj[jss::consensus] = to_string(phase);
 
+        PublishedJson const message{jvObj};
+
         for (auto i = streamMap.begin(); i != streamMap.end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->publish(message);
                 ++i;
             }
             else
@@ -2223,14 +2229,13 @@ NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
                 }
             });
 
+        PublishedJson const message{multiObj};
         for (auto i = mStreamMaps[sValidations].begin();
              i != mStreamMaps[sValidations].end();)
         {
             if (auto p = i->second.lock())
             {
-                multiObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(message);
                 ++i;
             }
             else
@@ -2252,6 +2257,8 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
         jvObj[jss::type] = "peerStatusChange";
 
+        PublishedJson const message{jvObj};
+
         for (auto i = mStreamMaps[sPeerStatus].begin();
              i != mStreamMaps[sPeerStatus].end();)
         {
@@ -2259,7 +2266,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->publish(message);
                 ++i;
             }
             else
@@ -2757,6 +2764,7 @@ NetworkOPsImp::pubProposedTransaction(
 {
     MultiApiJson jvObj =
         transJson(transaction, result, false, ledger, std::nullopt);
+    PublishedJson const message{jvObj};
 
     {
         std::lock_guard sl(mSubLock);
@@ -2768,9 +2776,7 @@ NetworkOPsImp::pubProposedTransaction(
 
             if (p)
             {
-                jvObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(message);
                 ++it;
             }
             else
@@ -2794,6 +2800,8 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
     {
         std::lock_guard sl(mSubLock);
 
+        PublishedJson const message{jvObj};
+
         auto it = mStreamMaps[sRTTransactions].begin();
         while (it != mStreamMaps[sRTTransactions].end())
         {
@@ -2801,7 +2809,7 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->publish(message);
                 ++it;
             }
             else
@@ -2819,12 +2827,14 @@ NetworkOPsImp::forwardValidation(Json::Value const& jvObj)
 {
     std::lock_guard sl(mSubLock);
 
+    PublishedJson const message{jvObj};
+
     for (auto i = mStreamMaps[sValidations].begin();
          i != mStreamMaps[sValidations].end();)
     {
         if (auto p = i->second.lock())
         {
-            p->send(jvObj, true);
+            p->publish(message);
             ++i;
         }
         else
@@ -2839,12 +2849,14 @@ NetworkOPsImp::forwardManifest(Json::Value const& jvObj)
 {
     std::lock_guard sl(mSubLock);
 
+    PublishedJson const message{jvObj};
+
     for (auto i = mStreamMaps[sManifests].begin();
          i != mStreamMaps[sManifests].end();)
     {
         if (auto p = i->second.lock())
         {
-            p->send(jvObj, true);
+            p->publish(message);
             ++i;
         }
         else
@@ -2935,8 +2947,10 @@ NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
 
     if (!notify.empty())
     {
+        PublishedJson const message{jvObj};
+
         for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+            isrListener->publish(message);
     }
 }
 
@@ -2990,13 +3004,15 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                     app_.getLedgerMaster().getCompleteLedgers();
             }
 
+            PublishedJson const message{jvObj};
+
             auto it = mStreamMaps[sLedger].begin();
             while (it != mStreamMaps[sLedger].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->publish(message);
                     ++it;
                 }
                 else
@@ -3008,13 +3024,15 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
         {
             Json::Value jvObj = ripple::RPC::computeBookChanges(lpAccepted);
 
+            PublishedJson const message{jvObj};
+
             auto it = mStreamMaps[sBookChanges].begin();
             while (it != mStreamMaps[sBookChanges].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->publish(message);
                     ++it;
                 }
                 else
@@ -3200,6 +3218,7 @@ NetworkOPsImp::pubValidatedTransaction(
     auto const metaRef = std::ref(transaction.getMeta());
     auto const trResult = transaction.getResult();
     MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
+    PublishedJson const message{jvObj};
 
     {
         std::lock_guard sl(mSubLock);
@@ -3211,9 +3230,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                jvObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(message);
                 ++it;
             }
             else
@@ -3228,9 +3245,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                jvObj.visit(
-                    p->getApiVersion(),  //
-                    [&](Json::Value const& jv) { p->send(jv, true); });
+                p->publish(message);
                 ++it;
             }
             else
@@ -3348,11 +3363,10 @@ NetworkOPsImp::pubAccountTransaction(
         auto const trResult = transaction.getResult();
         MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
 
-        for (InfoSub::ref isrListener : notify)
         {
-            jvObj.visit(
-                isrListener->getApiVersion(),  //
-                [&](Json::Value const& jv) { isrListener->send(jv, true); });
+            PublishedJson const message{jvObj};
+            for (InfoSub::ref isrListener : notify)
+                isrListener->publish(message);
         }
 
         if (last)
@@ -3428,10 +3442,11 @@ NetworkOPsImp::pubProposedAccountTransaction(
         // Create two different Json objects, for different API versions
         MultiApiJson jvObj = transJson(tx, result, false, ledger, std::nullopt);
 
-        for (InfoSub::ref isrListener : notify)
-            jvObj.visit(
-                isrListener->getApiVersion(),  //
-                [&](Json::Value const& jv) { isrListener->send(jv, true); });
+        {
+            PublishedJson const message{jvObj};
+            for (InfoSub::ref isrListener : notify)
+                isrListener->publish(message);
+        }
 
         assert(
             jvObj.isMember(jss::account_history_tx_stream) ==
@@ -32,6 +32,9 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <exception>
+#include <system_error>
+
 namespace ripple {
 void
 SHAMapStoreImp::SavedStateDB::init(
@@ -142,6 +145,13 @@ SHAMapStoreImp::SHAMapStoreImp(
             recoveryWaitTime_ = std::chrono::seconds{temp};
 
         get_if_exists(section, "advisory_delete", advisoryDelete_);
+        get_if_exists(section, "rotation_incremental", rotationIncremental_);
+        get_if_exists(section, "rotation_copy_rate", rotationCopyRate_);
+        if (get_if_exists(section, "rotation_threads", rotationThreads_) &&
+            rotationThreads_ == 0)
+        {
+            Throw<std::runtime_error>("rotation_threads must be at least 1");
+        }
 
         auto const minInterval = config.standalone()
             ? minimumDeletionIntervalSA_
@@ -259,20 +269,110 @@ SHAMapStoreImp::fdRequired() const
 }
 
 bool
-SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
+SHAMapStoreImp::copyState(
+    std::shared_ptr<SHAMap const> const& map,
+    std::uint64_t& nodeCount)
 {
-    // Copy a single record from node to dbRotating_
-    dbRotating_->fetchNodeObject(
-        node.getHash().as_uint256(),
-        0,
-        NodeStore::FetchType::synchronous,
-        true);
-    if (!(++nodeCount % checkHealthInterval_))
-    {
+    if (map->getHash().isZero())
+        return true;
+
+    auto const start = std::chrono::steady_clock::now();
+    std::atomic<std::uint64_t> count = 0;
+    std::atomic<bool> stopped = false;
+
+    // Copy a single record to the writable backend, periodically checking
+    // health and keeping within the configured copy rate
+    auto const copy = [&](SHAMapHash const& hash) {
+        dbRotating_->fetchNodeObject(
+            hash.as_uint256(), 0, NodeStore::FetchType::synchronous, true);
+
+        auto const n = ++count;
+        if (n % checkHealthInterval_)
+            return;
+
         if (healthWait() == stopping)
-            return false;
+        {
+            stopped = true;
+            return;
+        }
+
+        if (rotationCopyRate_)
+        {
+            auto const due = start +
+                std::chrono::milliseconds{n * 1000 / rotationCopyRate_};
+            std::this_thread::sleep_until(due);
+        }
+    };
+
+    std::exception_ptr error;
+    if (lastCopied_)
+    {
+        // Every node of the last copied map is in the writable backend, so
+        // only the nodes which changed since need to be copied
+        map->visitDifferences(
+            lastCopied_.get(), [&](SHAMapTreeNode const& node) {
+                copy(node.getHash());
+                return !stopped;
+            });
+    }
+    else
+    {
+        std::atomic<int> next = 0;
+        std::mutex errorMutex;
+        auto const work = [&]() {
+            try
+            {
+                for (int branch; !stopped && (branch = next++) < 16;)
+                    map->visitBranch(branch, [&](SHAMapTreeNode& node) {
+                        if (stopped)
+                            return false;
+                        copy(node.getHash());
+                        return true;
+                    });
+            }
+            catch (...)
+            {
+                stopped = true;
+                std::lock_guard lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+
+        copy(map->getHash());
+
+        std::vector<std::thread> workers;
+        workers.reserve(rotationThreads_ - 1);
+        for (std::uint32_t i = 1; i < rotationThreads_; ++i)
+        {
+            try
+            {
+                workers.emplace_back(work);
+            }
+            catch (std::system_error const& e)
+            {
+                JLOG(journal_.warn())
+                    << "Unable to start rotation copy thread: " << e.what();
+                break;
+            }
+        }
+
+        work();
+        for (auto& worker : workers)
+            worker.join();
     }
 
+    nodeCount += count;
+    if (error)
+        std::rethrow_exception(error);
+
+    if (stopped)
+        return false;
+
+    if (lastCopied_)
+        lastIncrementalCount_ = count.load();
+    if (rotationIncremental_)
+        lastCopied_ = map;
     return true;
 }
 
@@ -367,12 +467,9 @@ SHAMapStoreImp::run()
 
             try
             {
-                validatedLedger->stateMap().snapShot(false)->visitNodes(
-                    std::bind(
-                        &SHAMapStoreImp::copyNode,
-                        this,
-                        std::ref(nodeCount),
-                        std::placeholders::_1));
+                if (!copyState(
+                        validatedLedger->stateMap().snapShot(false), nodeCount))
+                    return;
             }
             catch (SHAMapMissingNode const& e)
             {
@@ -419,8 +516,39 @@ SHAMapStoreImp::run()
                     return std::move(newBackend);
                 });
 
+            // Nothing is in the new writable backend yet
+            lastCopied_.reset();
+
             JLOG(journal_.warn()) << "finished rotation " << validatedSeq;
         }
+        else if (
+            rotationIncremental_ &&
+            validatedSeq >= lastRotated + deleteInterval_ / 2 &&
+            healthWait() == keepGoing)
+        {
+            // Copy ahead of the rotation, so that it only has to copy what
+            // changed since. Each pass only visits subtrees which changed
+            // since the previous one.
+            std::uint64_t nodeCount = 0;
+
+            try
+            {
+                if (!copyState(
+                        validatedLedger->stateMap().snapShot(false), nodeCount))
+                    return;
+            }
+            catch (SHAMapMissingNode const& e)
+            {
+                JLOG(journal_.warn())
+                    << "Missing node while copying ledger ahead of rotate: "
+                    << e.what();
+                continue;
+            }
+
+            JLOG(journal_.debug()) << "copied ledger " << validatedSeq
+                                   << " ahead of rotation, nodecount "
+                                   << nodeCount;
+        }
     }
 }
 
@@ -109,6 +109,21 @@ private:
     /// recovery.
     /// See also: "recovery_wait_seconds" in rippled-example.cfg
     std::chrono::seconds recoveryWaitTime_{5};
+    // Threads walking the state map when copying it before a rotation
+    std::uint32_t rotationThreads_ = 1;
+    // Upper bound on nodes copied per second, or zero for no limit
+    std::uint32_t rotationCopyRate_ = 0;
+    // Copy the state map ahead of rotation, in passes which only copy what
+    // changed since the previous one
+    bool rotationIncremental_ = false;
+
+    // The last state map copied in full to the writable backend since it
+    // was created. Only kept in incremental rotation mode, so that the
+    // next copy can be limited to the nodes which changed since.
+    std::shared_ptr<SHAMap const> lastCopied_;
+    // Nodes copied by the last pass limited to the differences from
+    // lastCopied_
+    std::atomic<std::uint64_t> lastIncrementalCount_{0};
 
     // these do not exist upon SHAMapStore creation, but do exist
     // as of run() or before
@@ -176,10 +191,32 @@ public:
     std::optional<LedgerIndex>
     minimumOnline() const override;
 
+    /** Return how many nodes the last incremental copy wrote.
+
+        An incremental copy only writes the nodes of a state map which
+        changed since the map copied before it.
+    */
+    std::uint64_t
+    lastIncrementalCount() const
+    {
+        return lastIncrementalCount_;
+    }
+
 private:
-    // callback for visitNodes
+    /** Copy every node of a state map to the writable backend
+
+        Subtrees below the root are copied in parallel. In incremental mode,
+        once a map has been copied only the differences from it are copied.
+
+        @param map The state map to copy.
+        @param nodeCount Incremented by the number of nodes copied.
+        @return Whether the copy completed; false if the server is stopping.
+        @throws SHAMapMissingNode if a node of the map is not available.
+    */
     bool
-    copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node);
+    copyState(
+        std::shared_ptr<SHAMap const> const& map,
+        std::uint64_t& nodeCount);
     void
     run();
     void
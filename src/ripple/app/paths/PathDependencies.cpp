@@ -0,0 +1,215 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/PathDependencies.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/TxMeta.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+std::shared_ptr<LedgerChanges const>
+LedgerChanges::make(ReadView const& ledger)
+{
+    if (ledger.open())
+        return nullptr;
+
+    auto changes = std::make_shared<LedgerChanges>();
+    changes->parentHash = ledger.info().parentHash;
+    changes->hash = ledger.info().hash;
+
+    for (auto const& [tx, meta] : ledger.txs)
+    {
+        if (!tx || !meta)
+            return nullptr;
+
+        TxMeta const txMeta(tx->getTransactionID(), ledger.seq(), *meta);
+        for (auto const& node : txMeta.getNodes())
+            changes->keys.push_back(node.getFieldH256(sfLedgerIndex));
+        for (auto const& account : txMeta.getAffectedAccounts())
+            changes->accounts.insert(account);
+    }
+
+    auto& keys = changes->keys;
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    changes->global =
+        std::binary_search(keys.begin(), keys.end(), keylet::fees().key) ||
+        std::binary_search(keys.begin(), keys.end(), keylet::amendments().key);
+
+    return changes;
+}
+
+//------------------------------------------------------------------------------
+
+static thread_local PathDependencies* currentDependencies = nullptr;
+
+PathDependencies::Recorder::Recorder(PathDependencies& deps)
+    : deps_(deps), saved_(currentDependencies)
+{
+    currentDependencies = &deps_;
+}
+
+PathDependencies::Recorder::~Recorder()
+{
+    currentDependencies = saved_;
+    deps_.compact();
+}
+
+PathDependencies*
+PathDependencies::current()
+{
+    return currentDependencies;
+}
+
+void
+PathDependencies::addEntry(
+    uint256 const& key,
+    std::shared_ptr<SLE const> const& sle)
+{
+    keys_.insert(key);
+    if (!sle)
+        return;
+
+    // Offers expire, and AMM auction slots stop discounting, once the
+    // parent close time reaches their expiration.
+    std::optional<std::uint32_t> expiration = (*sle)[~sfExpiration];
+    if (!expiration && sle->getType() == ltAMM &&
+        sle->isFieldPresent(sfAuctionSlot))
+    {
+        expiration = static_cast<STObject const&>(
+            sle->peekAtField(sfAuctionSlot))[~sfExpiration];
+    }
+
+    if (expiration)
+    {
+        NetClock::time_point const tp{NetClock::duration{*expiration}};
+        if (!expiration_ || tp < *expiration_)
+            expiration_ = tp;
+    }
+}
+
+void
+PathDependencies::addRange(
+    uint256 const& first,
+    std::optional<uint256> const& last)
+{
+    ranges_.emplace_back(first, last);
+}
+
+void
+PathDependencies::addAccount(AccountID const& account)
+{
+    accounts_.insert(account);
+}
+
+void
+PathDependencies::merge(PathDependencies const& other)
+{
+    keys_.insert(other.keys_.begin(), other.keys_.end());
+    ranges_.insert(ranges_.end(), other.ranges_.begin(), other.ranges_.end());
+    accounts_.insert(other.accounts_.begin(), other.accounts_.end());
+    if (other.expiration_ &&
+        (!expiration_ || *other.expiration_ < *expiration_))
+        expiration_ = other.expiration_;
+    compact();
+}
+
+void
+PathDependencies::compact()
+{
+    // Ranking candidate paths walks the same books many times.
+    std::sort(ranges_.begin(), ranges_.end());
+    ranges_.erase(std::unique(ranges_.begin(), ranges_.end()), ranges_.end());
+}
+
+bool
+PathDependencies::changedBy(
+    LedgerChanges const& changes,
+    NetClock::time_point parentCloseTime) const
+{
+    if (changes.global)
+        return true;
+
+    if (expiration_ && parentCloseTime >= *expiration_)
+        return true;
+
+    for (auto const& key : changes.keys)
+    {
+        if (keys_.count(key))
+            return true;
+    }
+
+    for (auto const& [first, last] : ranges_)
+    {
+        auto const it =
+            std::upper_bound(changes.keys.begin(), changes.keys.end(), first);
+        if (it != changes.keys.end() && (!last || *it <= *last))
+            return true;
+    }
+
+    for (auto const& account : changes.accounts)
+    {
+        if (accounts_.count(account))
+            return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
+RecordingView::RecordingView(std::shared_ptr<ReadView const> base)
+    : base_(std::move(base))
+{
+    // Record at one level only.
+    if (auto const view = dynamic_cast<RecordingView const*>(base_.get()))
+        base_ = view->base_;
+}
+
+bool
+RecordingView::exists(Keylet const& k) const
+{
+    if (auto const deps = PathDependencies::current())
+        deps->addEntry(k.key, nullptr);
+    return base_->exists(k);
+}
+
+std::shared_ptr<SLE const>
+RecordingView::read(Keylet const& k) const
+{
+    auto sle = base_->read(k);
+    if (auto const deps = PathDependencies::current())
+        deps->addEntry(k.key, sle);
+    return sle;
+}
+
+auto
+RecordingView::succ(key_type const& key, std::optional<key_type> const& last)
+    const -> std::optional<key_type>
+{
+    auto next = base_->succ(key, last);
+    if (auto const deps = PathDependencies::current())
+        deps->addRange(key, next ? next : last);
+    return next;
+}
+
+}  // namespace ripple
@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_PATHS_PATHDEPENDENCIES_H_INCLUDED
+#define RIPPLE_APP_PATHS_PATHDEPENDENCIES_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/AccountID.h>
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** The state entries and accounts a closed ledger changed.
+
+    Built from the metadata of the ledger's transactions.
+*/
+struct LedgerChanges
+{
+    /** The changes a ledger made to its parent's state.
+
+        @return nullptr if the ledger is open or lacks metadata.
+    */
+    static std::shared_ptr<LedgerChanges const>
+    make(ReadView const& ledger);
+
+    uint256 parentHash;
+    uint256 hash;
+
+    // The keys of the created, modified and deleted entries, sorted.
+    std::vector<uint256> keys;
+
+    // The accounts the transactions affected.
+    hash_set<AccountID> accounts;
+
+    // Whether state every path depends on, such as the fees or the
+    // amendments, changed.
+    bool global = false;
+};
+
+/** The ledger state a path finding result was computed from.
+
+    While a Recorder is in scope, the reads which path finding makes through
+    a RippleLineCache on the same thread are noted here. A result computed
+    on one ledger holds for the next if that ledger changes none of them.
+*/
+class PathDependencies
+{
+public:
+    /** Notes the reads made on this thread while in scope. */
+    class Recorder
+    {
+        PathDependencies& deps_;
+        PathDependencies* saved_;
+
+    public:
+        explicit Recorder(PathDependencies& deps);
+        ~Recorder();
+
+        Recorder(Recorder const&) = delete;
+        Recorder&
+        operator=(Recorder const&) = delete;
+    };
+
+    /** The dependencies being recorded on this thread, if any. */
+    static PathDependencies*
+    current();
+
+    /** Note that the entry with the key was read.
+
+        @param sle The entry, or nullptr if it was missing or only checked
+                   for.
+    */
+    void
+    addEntry(uint256 const& key, std::shared_ptr<SLE const> const& sle);
+
+    /** Note that no keys lie strictly after `first` and before `last`. */
+    void
+    addRange(uint256 const& first, std::optional<uint256> const& last);
+
+    /** Note that the trust lines of the account were used. */
+    void
+    addAccount(AccountID const& account);
+
+    /** Add the dependencies recorded by another search, such as one run on
+        a different thread for the same request.
+    */
+    void
+    merge(PathDependencies const& other);
+
+    /** Whether a ledger with the given changes may change the result.
+
+        @param changes The changes the ledger made to the state.
+        @param parentCloseTime The ledger's parent close time, against
+                               which offers and auction slots expire.
+    */
+    bool
+    changedBy(
+        LedgerChanges const& changes,
+        NetClock::time_point parentCloseTime) const;
+
+private:
+    void
+    compact();
+
+    hash_set<uint256> keys_;
+    // Half-open ranges (first, last]; an empty last extends to the end.
+    std::vector<std::pair<uint256, std::optional<uint256>>> ranges_;
+    hash_set<AccountID> accounts_;
+    std::optional<NetClock::time_point> expiration_;
+};
+
+/** A view which records the reads made through it.
+
+    The reads are recorded in the PathDependencies of the calling thread,
+    if any, and are otherwise passed straight to the underlying view. Path
+    finding only reads entries and steps between them with succ, so
+    iterating the entries or transactions is not recorded.
+*/
+class RecordingView final : public ReadView
+{
+    std::shared_ptr<ReadView const> base_;
+
+public:
+    explicit RecordingView(std::shared_ptr<ReadView const> base);
+
+    std::shared_ptr<ReadView const> const&
+    base() const
+    {
+        return base_;
+    }
+
+    bool
+    exists(Keylet const& k) const override;
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override;
+
+    std::optional<key_type>
+    succ(
+        key_type const& key,
+        std::optional<key_type> const& last = std::nullopt) const override;
+
+    bool
+    open() const override
+    {
+        return base_->open();
+    }
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_->info();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_->fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_->rules();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        return base_->slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        return base_->slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(uint256 const& key) const override
+    {
+        return base_->slesUpperBound(key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        return base_->txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        return base_->txsEnd();
+    }
+
+    bool
+    txExists(key_type const& key) const override
+    {
+        return base_->txExists(key);
+    }
+
+    tx_type
+    txRead(key_type const& key) const override
+    {
+        return base_->txRead(key);
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -724,16 +725,51 @@ PathRequest::doUpdate(
 
     JLOG(m_journal.debug()) << iIdentifier << " processing at level " << iLevel;
 
-    Json::Value jvArray = Json::arrayValue;
-    if (findPaths(cache, iLevel, jvArray, continueCallback))
+    if (!fast && canReuse(cache))
     {
-        bLastSuccess = jvArray.size() != 0;
-        newStatus[jss::alternatives] = std::move(jvArray);
+        JLOG(m_journal.debug())
+            << iIdentifier << " reusing paths from an earlier ledger";
+        newStatus[jss::alternatives] = lastFull_->alternatives;
+        mOwner.reportReused();
     }
     else
     {
-        bLastSuccess = false;
-        newStatus = rpcError(rpcINTERNAL);
+        lastFull_.reset();
+
+        PathDependencies dependencies;
+        auto const bookGeneration = app_.getOrderBookDB().generation();
+        Json::Value jvArray = Json::arrayValue;
+        bool found;
+        {
+            PathDependencies::Recorder recorder(dependencies);
+            found = findPaths(cache, iLevel, jvArray, continueCallback);
+        }
+
+        if (found)
+        {
+            bLastSuccess = jvArray.size() != 0;
+
+            // The changes made by open ledgers are not known, and an
+            // abandoned search may be incomplete.
+            auto const& ledger = cache->getLedger();
+            if (!fast && !ledger->open() &&
+                (!continueCallback || continueCallback()))
+            {
+                lastFull_ = FullResult{
+                    jvArray,
+                    std::move(dependencies),
+                    iLevel,
+                    bookGeneration,
+                    ledger->info().hash};
+            }
+
+            newStatus[jss::alternatives] = std::move(jvArray);
+        }
+        else
+        {
+            bLastSuccess = false;
+            newStatus = rpcError(rpcINTERNAL);
+        }
     }
 
     if (fast && quick_reply_ == steady_clock::time_point{})
@@ -757,6 +793,30 @@ PathRequest::doUpdate(
     return newStatus;
 }
 
+bool
+PathRequest::canReuse(std::shared_ptr<RippleLineCache> const& cache)
+{
+    // The search level and the set of order books shape the result as much
+    // as the ledger does.
+    if (!lastFull_ || lastFull_->level != iLevel ||
+        lastFull_->bookGeneration != app_.getOrderBookDB().generation())
+        return false;
+
+    auto const& ledger = cache->getLedger();
+    if (ledger->info().hash == lastFull_->ledgerHash)
+        return true;
+
+    // Only a ledger built on one the result holds for can be checked.
+    auto const& changes = cache->getChanges();
+    if (!changes || changes->parentHash != lastFull_->ledgerHash ||
+        lastFull_->dependencies.changedBy(
+            *changes, ledger->info().parentCloseTime))
+        return false;
+
+    lastFull_->ledgerHash = changes->hash;
+    return true;
+}
+
 InfoSub::pointer
 PathRequest::getSubscriber() const
 {
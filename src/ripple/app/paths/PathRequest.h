@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PATHS_PATHREQUEST_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/paths/PathDependencies.h>
 #include <ripple/app/paths/Pathfinder.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/json/json_value.h>
@@ -132,6 +133,10 @@ private:
     int
     parseJson(Json::Value const&);
 
+    /** Whether the last full result holds for the cache's ledger. */
+    bool
+    canReuse(std::shared_ptr<RippleLineCache> const& cache);
+
     Application& app_;
     beast::Journal m_journal;
 
@@ -164,6 +169,19 @@ private:
     int iLevel;
     bool bLastSuccess;
 
+    // The last full result and what it was computed from, so that it can
+    // be reused on later ledgers which change none of it.
+    struct FullResult
+    {
+        Json::Value alternatives;
+        PathDependencies dependencies;
+        int level;
+        std::uint64_t bookGeneration;
+        // The latest ledger the result is known to hold for
+        uint256 ledgerHash;
+    };
+    std::optional<FullResult> lastFull_;
+
     int const iIdentifier;
 
     std::chrono::steady_clock::time_point const created_;
@@ -98,6 +98,19 @@ public:
         mFull.notify(ms);
     }
 
+    void
+    reportReused()
+    {
+        ++reused_;
+    }
+
+    /** The number of full updates answered with an earlier result. */
+    std::uint64_t
+    getReusedCount() const
+    {
+        return reused_;
+    }
+
 private:
     void
     insertPathRequest(PathRequest::pointer const&);
@@ -116,6 +129,8 @@ private:
 
     std::atomic<int> mLastIdentifier;
 
+    std::atomic<std::uint64_t> reused_{0};
+
     std::recursive_mutex mutable mLock;
 };
 
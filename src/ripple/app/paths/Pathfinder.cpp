@@ -19,6 +19,7 @@
 
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/paths/PathDependencies.h>
 #include <ripple/app/paths/Pathfinder.h>
 #include <ripple/app/paths/RippleCalc.h>
 #include <ripple/app/paths/RippleLineCache.h>
@@ -30,6 +31,12 @@
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/PaymentSandbox.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
 #include <tuple>
 
 /*
@@ -509,13 +516,32 @@ Pathfinder::rankPaths(
         return largestAmount(mDstAmount);
     }();
 
-    for (int i = 0; i < paths.size(); ++i)
-    {
-        if (continueCallback && !continueCallback())
-            return;
-        auto const& currentPath = paths[i];
-        if (!currentPath.empty())
+    // The candidates do not affect one another: each is checked in its own
+    // sandbox over the same read-only ledger. So they can be checked on
+    // several threads and gathered in their original order afterwards.
+    std::vector<std::optional<PathRank>> ranks(paths.size());
+    std::atomic<std::size_t> next = 0;
+    std::atomic<bool> stopped = false;
+    std::mutex callbackMutex;
+
+    auto check = [&]() {
+        for (std::size_t i = next++; i < paths.size(); i = next++)
         {
+            if (stopped)
+                return;
+            if (continueCallback)
+            {
+                std::lock_guard lock(callbackMutex);
+                if (!continueCallback())
+                {
+                    stopped = true;
+                    return;
+                }
+            }
+            auto const& currentPath = paths[i];
+            if (currentPath.empty())
+                continue;
+
             STAmount liquidity;
             uint64_t uQuality;
             auto const resultCode = getPathLiquidity(
@@ -531,11 +557,84 @@ Pathfinder::rankPaths(
                 JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
                                  << currentPath.getJson(JsonOptions::none);
 
-                rankedPaths.push_back(
-                    {uQuality, currentPath.size(), liquidity, i});
+                ranks[i] = PathRank{
+                    uQuality,
+                    currentPath.size(),
+                    liquidity,
+                    static_cast<int>(i)};
             }
         }
+    };
+
+    // Each candidate takes a full payment simulation, so a few per thread
+    // are enough to repay starting it. Path searches run for any client, so
+    // the configuration limits how many cores a single one may take.
+    std::size_t constexpr minPathsPerThread = 4;
+    auto const threads = std::min<std::size_t>(
+        {static_cast<std::size_t>(app_.config().PATH_SEARCH_THREADS),
+         std::thread::hardware_concurrency(),
+         paths.size() / minPathsPerThread});
+
+    if (threads < 2)
+    {
+        check();
     }
+    else
+    {
+        // The amounts computed depend on state kept per thread, which the
+        // workers must share with this one.
+        auto const rules = getCurrentTransactionRules();
+        auto const switchover = getSTNumberSwitchover();
+        auto const round = Number::getround();
+        auto* const dependencies = PathDependencies::current();
+        std::vector<PathDependencies> workerDependencies(threads - 1);
+
+        auto work = [&](PathDependencies& deps) {
+            setCurrentTransactionRules(rules);
+            NumberSO stNumberSO{switchover};
+            saveNumberRoundMode savedRound{Number::setround(round)};
+            std::optional<PathDependencies::Recorder> recorder;
+            if (dependencies)
+                recorder.emplace(deps);
+            check();
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (auto& deps : workerDependencies)
+        {
+            try
+            {
+                workers.emplace_back(work, std::ref(deps));
+            }
+            catch (std::system_error const& e)
+            {
+                JLOG(j_.warn())
+                    << "Unable to start path ranking thread: " << e.what();
+                break;
+            }
+        }
+
+        check();
+
+        for (auto& worker : workers)
+            worker.join();
+
+        if (dependencies)
+        {
+            for (auto const& deps : workerDependencies)
+                dependencies->merge(deps);
+        }
+    }
+
+    for (auto& rank : ranks)
+    {
+        if (rank)
+            rankedPaths.push_back(std::move(*rank));
+    }
+
+    if (stopped)
+        return;
 
     // Sort paths by:
     //    cost of path (when considering quality)
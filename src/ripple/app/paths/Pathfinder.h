@@ -186,6 +186,9 @@ private:
         AccountID const& toAccount,
         Currency const& currency);
 
+    // Compute the liquidity of each path and sort the ones worth keeping.
+    // With enough candidates the paths are checked on several threads; the
+    // result is the same as checking them one at a time.
     void
     rankPaths(
         int maxPaths,
@@ -26,7 +26,7 @@ namespace ripple {
 RippleLineCache::RippleLineCache(
     std::shared_ptr<ReadView const> const& ledger,
     beast::Journal j)
-    : ledger_(ledger), journal_(j)
+    : ledger_(std::make_shared<RecordingView>(ledger)), journal_(j)
 {
     JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq;
 }
@@ -43,6 +43,11 @@ RippleLineCache::getRippleLines(
     AccountID const& accountID,
     LineDirection direction)
 {
+    // The lines may come from the cache rather than the ledger, so note
+    // the account: any change to its lines affects it.
+    if (auto const deps = PathDependencies::current())
+        deps->addAccount(accountID);
+
     auto const hash = hasher_(accountID);
     AccountKey key(accountID, direction, hash);
     AccountKey otherkey(
@@ -125,4 +130,13 @@ RippleLineCache::getRippleLines(
     return it->second;
 }
 
+std::shared_ptr<LedgerChanges const> const&
+RippleLineCache::getChanges()
+{
+    std::lock_guard sl(mLock);
+    if (!changes_)
+        changes_ = LedgerChanges::make(*ledger_);
+    return *changes_;
+}
+
 }  // namespace ripple
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PATHS_RIPPLELINECACHE_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/paths/PathDependencies.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/basics/hardened_hash.h>
@@ -28,6 +29,7 @@
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace ripple {
@@ -41,12 +43,20 @@ public:
         beast::Journal j);
     ~RippleLineCache();
 
+    /** The ledger, as a view which records the reads of path finding. */
     std::shared_ptr<ReadView const> const&
     getLedger() const
     {
         return ledger_;
     }
 
+    /** The changes the ledger made to its parent's state.
+
+        @return nullptr if they are not known.
+    */
+    std::shared_ptr<LedgerChanges const> const&
+    getChanges();
+
     /** Find the trust lines associated with an account.
 
        @param accountID The account
@@ -70,6 +80,8 @@ private:
 
     beast::Journal journal_;
 
+    std::optional<std::shared_ptr<LedgerChanges const>> changes_;
+
     struct AccountKey final : public CountedObject<AccountKey>
     {
         AccountID account_;
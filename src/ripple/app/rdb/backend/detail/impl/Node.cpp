@@ -246,98 +246,132 @@ saveValidatedLedger(
     }
 
     {
-        static boost::format deleteLedger(
-            "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
-        static boost::format deleteTrans1(
-            "DELETE FROM Transactions WHERE LedgerSeq = %u;");
-        static boost::format deleteTrans2(
-            "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-        static boost::format deleteAcctTrans(
-            "DELETE FROM AccountTransactions WHERE TransID = '%s';");
-
         {
             auto db = ldgDB.checkoutDb();
-            *db << boost::str(deleteLedger % seq);
+            *db << "DELETE FROM Ledgers WHERE LedgerSeq = :seq;",
+                soci::use(seq);
         }
 
         if (app.config().useTxTables())
         {
+            auto const start = std::chrono::steady_clock::now();
+            std::size_t rows = 0;
+
             auto db = txnDB.checkoutDb();
 
             soci::transaction tr(*db);
 
-            *db << boost::str(deleteTrans1 % seq);
-            *db << boost::str(deleteTrans2 % seq);
-
-            std::string const ledgerSeq(std::to_string(seq));
-
+            *db << "DELETE FROM Transactions WHERE LedgerSeq = :seq;",
+                soci::use(seq);
+            *db << "DELETE FROM AccountTransactions WHERE LedgerSeq = :seq;",
+                soci::use(seq);
+
+            // Each statement is prepared once per ledger and executed for
+            // every row, with the values bound rather than formatted into
+            // the SQL.
+            std::string txnId;
+            std::string txnType;
+            std::string fromAcct;
+            std::uint32_t fromSeq = 0;
+            std::string const status(1, txnSqlValidated);
+            std::string account;
+            std::uint32_t txnSeq = 0;
+            soci::blob rawTxn(*db);
+            soci::blob txnMeta(*db);
+
+            soci::statement deleteAcctTrans =
+                (db->prepare << "DELETE FROM AccountTransactions "
+                                "WHERE TransID = :txnId;",
+                 soci::use(txnId));
+
+            soci::statement insertAcctTrans =
+                (db->prepare << "INSERT INTO AccountTransactions "
+                                "(TransID, Account, LedgerSeq, TxnSeq) "
+                                "VALUES (:txnId, :account, :seq, :txnSeq);",
+                 soci::use(txnId),
+                 soci::use(account),
+                 soci::use(seq),
+                 soci::use(txnSeq));
+
+            soci::statement insertTrans =
+                (db->prepare
+                     << "INSERT OR REPLACE INTO Transactions "
+                        "(TransID, TransType, FromAcct, FromSeq, LedgerSeq, "
+                        "Status, RawTxn, TxnMeta) "
+                        "VALUES (:txnId, :txnType, :fromAcct, :fromSeq, "
+                        ":seq, :status, :rawTxn, :txnMeta);",
+                 soci::use(txnId),
+                 soci::use(txnType),
+                 soci::use(fromAcct),
+                 soci::use(fromSeq),
+                 soci::use(seq),
+                 soci::use(status),
+                 soci::use(rawTxn),
+                 soci::use(txnMeta));
+
+            Serializer s;
             for (auto const& acceptedLedgerTx : *aLedger)
             {
+                auto const& txn = acceptedLedgerTx->getTxn();
                 uint256 transactionID = acceptedLedgerTx->getTransactionID();
 
-                std::string const txnId(to_string(transactionID));
-                std::string const txnSeq(
-                    std::to_string(acceptedLedgerTx->getTxnSeq()));
+                txnId = to_string(transactionID);
+                txnSeq = acceptedLedgerTx->getTxnSeq();
 
-                *db << boost::str(deleteAcctTrans % transactionID);
+                deleteAcctTrans.execute(true);
 
                 auto const& accts = acceptedLedgerTx->getAffected();
 
                 if (!accts.empty())
                 {
-                    std::string sql(
-                        "INSERT INTO AccountTransactions "
-                        "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                    // Try to make an educated guess on how much space we'll
-                    // need for our arguments. In argument order we have: 64
-                    // + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                    sql.reserve(sql.length() + (accts.size() * 128));
-
-                    bool first = true;
-                    for (auto const& account : accts)
+                    for (auto const& acct : accts)
                     {
-                        if (!first)
-                            sql += ", ('";
-                        else
-                        {
-                            sql += "('";
-                            first = false;
-                        }
-
-                        sql += txnId;
-                        sql += "','";
-                        sql += toBase58(account);
-                        sql += "',";
-                        sql += ledgerSeq;
-                        sql += ",";
-                        sql += txnSeq;
-                        sql += ")";
+                        account = toBase58(acct);
+                        insertAcctTrans.execute(true);
                     }
-                    sql += ";";
-                    JLOG(j.trace()) << "ActTx: " << sql;
-                    *db << sql;
+                    rows += accts.size();
                 }
-                else if (auto const& sleTxn = acceptedLedgerTx->getTxn();
-                         !isPseudoTx(*sleTxn))
+                else if (!isPseudoTx(*txn))
                 {
                     // It's okay for pseudo transactions to not affect any
                     // accounts.  But otherwise...
                     JLOG(j.warn()) << "Transaction in ledger " << seq
                                    << " affects no accounts";
-                    JLOG(j.warn()) << sleTxn->getJson(JsonOptions::none);
+                    JLOG(j.warn()) << txn->getJson(JsonOptions::none);
                 }
 
-                *db
-                    << (STTx::getMetaSQLInsertReplaceHeader() +
-                        acceptedLedgerTx->getTxn()->getMetaSQL(
-                            seq, acceptedLedgerTx->getEscMeta()) +
-                        ";");
+                auto const format =
+                    TxFormats::getInstance().findByType(txn->getTxnType());
+                assert(format != nullptr);
+                txnType = format->getName();
+                fromAcct = toBase58(txn->getAccountID(sfAccount));
+                fromSeq = txn->getFieldU32(sfSequence);
+
+                s.erase();
+                txn->add(s);
+                // The backend keeps the largest size written unless trimmed.
+                rawTxn.trim(0);
+                convert(s.peekData(), rawTxn);
+                txnMeta.trim(0);
+                convert(acceptedLedgerTx->getRawMeta(), txnMeta);
+
+                insertTrans.execute(true);
+                ++rows;
 
                 app.getMasterTransaction().inLedger(transactionID, seq);
             }
 
             tr.commit();
+
+            auto const elapsed =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start);
+            JLOG(j.debug()) << "saveValidatedLedger " << seq << ": wrote "
+                            << rows << " transaction rows in "
+                            << elapsed.count() << "us ("
+                            << (rows * 1000000 /
+                                std::max<std::int64_t>(elapsed.count(), 1))
+                            << " rows/s)";
         }
 
         {
@@ -1107,61 +1141,46 @@ accountTxPage(
     if (limit_used > 0)
         newmarker = options.marker;
 
-    static std::string const prefix(
+    // A single range over AcctTxIndex, in index order, so SQLite stops
+    // reading once the page is full instead of sorting every transaction
+    // of the account in the range. The last condition skips the part of
+    // the marker's ledger before the marker; without a marker, findLedger
+    // is 0, which no ledger matches.
+    static std::string const forwardSql(
         R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
           Status,RawTxn,TxnMeta
           FROM AccountTransactions INNER JOIN Transactions
           ON Transactions.TransID = AccountTransactions.TransID
-          AND AccountTransactions.Account = '%s' WHERE
-          )");
-
-    std::string sql;
+          WHERE AccountTransactions.Account = :account AND
+          AccountTransactions.LedgerSeq BETWEEN :minLedger AND :maxLedger AND
+          (AccountTransactions.LedgerSeq <> :findLedger OR
+          AccountTransactions.TxnSeq >= :findSeq)
+          ORDER BY AccountTransactions.LedgerSeq ASC,
+          AccountTransactions.TxnSeq ASC
+          LIMIT :limit;)");
+    static std::string const backwardSql(
+        R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
+          Status,RawTxn,TxnMeta
+          FROM AccountTransactions INNER JOIN Transactions
+          ON Transactions.TransID = AccountTransactions.TransID
+          WHERE AccountTransactions.Account = :account AND
+          AccountTransactions.LedgerSeq BETWEEN :minLedger AND :maxLedger AND
+          (AccountTransactions.LedgerSeq <> :findLedger OR
+          AccountTransactions.TxnSeq <= :findSeq)
+          ORDER BY AccountTransactions.LedgerSeq DESC,
+          AccountTransactions.TxnSeq DESC
+          LIMIT :limit;)");
 
     // SQL's BETWEEN uses a closed interval ([a,b])
-
-    const char* const order = forward ? "ASC" : "DESC";
-
-    if (findLedger == 0)
+    std::string const account = toBase58(options.account);
+    std::uint32_t minLedger = options.minLedger;
+    std::uint32_t maxLedger = options.maxLedger;
+    if (findLedger != 0)
     {
-        sql = boost::str(
-            boost::format(
-                prefix + (R"(AccountTransactions.LedgerSeq BETWEEN %u AND %u
-             ORDER BY AccountTransactions.LedgerSeq %s,
-             AccountTransactions.TxnSeq %s
-             LIMIT %u;)")) %
-            toBase58(options.account) % options.minLedger % options.maxLedger %
-            order % order % queryLimit);
-    }
-    else
-    {
-        const char* const compare = forward ? ">=" : "<=";
-        const std::uint32_t minLedger =
-            forward ? findLedger + 1 : options.minLedger;
-        const std::uint32_t maxLedger =
-            forward ? options.maxLedger : findLedger - 1;
-
-        auto b58acct = toBase58(options.account);
-        sql = boost::str(
-            boost::format((
-                R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-            Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq BETWEEN %u AND %u)
-            UNION
-            SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq = %u AND
-            AccountTransactions.TxnSeq %s %u)
-            ORDER BY AccountTransactions.LedgerSeq %s,
-            AccountTransactions.TxnSeq %s
-            LIMIT %u;
-            )")) %
-            b58acct % minLedger % maxLedger % b58acct % findLedger % compare %
-            findSeq % order % order % queryLimit);
+        if (forward)
+            minLedger = findLedger;
+        else
+            maxLedger = findLedger;
     }
 
     {
@@ -1177,12 +1196,18 @@ accountTxPage(
         soci::indicator dataPresent, metaPresent;
 
         soci::statement st =
-            (session.prepare << sql,
+            (session.prepare << (forward ? forwardSql : backwardSql),
              soci::into(ledgerSeq),
              soci::into(txnSeq),
              soci::into(status),
              soci::into(txnData, dataPresent),
-             soci::into(txnMeta, metaPresent));
+             soci::into(txnMeta, metaPresent),
+             soci::use(account),
+             soci::use(minLedger),
+             soci::use(maxLedger),
+             soci::use(findLedger),
+             soci::use(findSeq),
+             soci::use(queryLimit));
 
         st.execute();
 
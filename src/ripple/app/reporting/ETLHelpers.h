@@ -169,6 +169,14 @@ public:
             cv_.notify_all();
         return ret;
     }
+
+    /// @return the number of elements in the queue
+    std::size_t
+    size() const
+    {
+        std::lock_guard lck(m_);
+        return queue_.size();
+    }
 };
 
 /// Parititions the uint256 keyspace into numMarkers partitions, each of equal
@@ -466,7 +466,7 @@ public:
     process(
         std::unique_ptr<org::xrpl::rpc::v1::XRPLedgerAPIService::Stub>& stub,
         grpc::CompletionQueue& cq,
-        ThreadSafeQueue<std::shared_ptr<SLE>>& queue,
+        ThreadSafeQueue<LedgerDataPage>& queue,
         bool abort = false)
     {
         JLOG(journal_.debug()) << "Processing calldata";
@@ -510,19 +510,10 @@ public:
             call(stub, cq);
         }
 
-        for (auto& obj : cur_->ledger_objects().objects())
-        {
-            auto key = uint256::fromVoidChecked(obj.key());
-            if (!key)
-                throw std::runtime_error("Received malformed object ID");
-
-            auto& data = obj.data();
-
-            SerialIter it{data.data(), data.size()};
-            std::shared_ptr<SLE> sle = std::make_shared<SLE>(it, *key);
-
-            queue.push(sle);
-        }
+        // The objects are deserialized by the decode threads, so that this
+        // thread can get back to the completion queue.
+        queue.push(LedgerDataPage{std::move(cur_)});
+        cur_ = std::make_unique<org::xrpl::rpc::v1::GetLedgerDataResponse>();
 
         return more ? CallStatus::MORE : CallStatus::DONE;
     }
@@ -556,7 +547,7 @@ public:
 bool
 ETLSource::loadInitialLedger(
     uint32_t sequence,
-    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue)
+    ThreadSafeQueue<LedgerDataPage>& decodeQueue)
 {
     if (!stub_)
         return false;
@@ -603,7 +594,7 @@ ETLSource::loadInitialLedger(
         {
             JLOG(journal_.debug())
                 << "Marker prefix = " << ptr->getMarkerPrefix();
-            auto result = ptr->process(stub_, cq, writeQueue, abort);
+            auto result = ptr->process(stub_, cq, decodeQueue, abort);
             if (result != AsyncCallData::CallStatus::MORE)
             {
                 numFinished++;
@@ -679,11 +670,11 @@ ETLLoadBalancer::add(std::string& host, std::string& websocketPort)
 void
 ETLLoadBalancer::loadInitialLedger(
     uint32_t sequence,
-    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue)
+    ThreadSafeQueue<LedgerDataPage>& decodeQueue)
 {
     execute(
-        [this, &sequence, &writeQueue](auto& source) {
-            bool res = source->loadInitialLedger(sequence, writeQueue);
+        [this, &sequence, &decodeQueue](auto& source) {
+            bool res = source->loadInitialLedger(sequence, decodeQueue);
             if (!res)
             {
                 JLOG(journal_.error()) << "Failed to download initial ledger. "
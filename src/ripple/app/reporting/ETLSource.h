@@ -36,6 +36,13 @@ namespace ripple {
 
 class ReportingETL;
 
+/// One page of ledger objects, as downloaded during the initial ledger load
+using LedgerDataPage =
+    std::shared_ptr<org::xrpl::rpc::v1::GetLedgerDataResponse>;
+
+/// The ledger objects of one page, deserialized and ready to be written
+using LedgerObjects = std::vector<std::shared_ptr<SLE>>;
+
 /// This class manages a connection to a single ETL source. This is almost
 /// always a p2p node, but really could be another reporting node. This class
 /// subscribes to the ledgers and transactions_proposed streams of the
@@ -244,12 +251,12 @@ public:
 
     /// Download a ledger in full
     /// @param ledgerSequence sequence of the ledger to download
-    /// @param writeQueue queue to push downloaded ledger objects
+    /// @param decodeQueue queue to push downloaded pages of ledger objects
     /// @return true if the download was successful
     bool
     loadInitialLedger(
         uint32_t ledgerSequence,
-        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue);
+        ThreadSafeQueue<LedgerDataPage>& decodeQueue);
 
     /// Begin sequence of operations to connect to the ETL source and subscribe
     /// to ledgers and transactions_proposed
@@ -339,13 +346,13 @@ public:
     void
     add(std::string& host, std::string& websocketPort);
 
-    /// Load the initial ledger, writing data to the queue
+    /// Load the initial ledger, pushing the downloaded pages to the queue
     /// @param sequence sequence of ledger to download
-    /// @param writeQueue queue to push downloaded data to
+    /// @param decodeQueue queue to push downloaded pages to
     void
     loadInitialLedger(
         uint32_t sequence,
-        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue);
+        ThreadSafeQueue<LedgerDataPage>& decodeQueue);
 
     /// Fetch data for a specific ledger. This function will continuously try
     /// to fetch data for the specified ledger until the fetch succeeds, the
@@ -50,26 +50,101 @@ toString(LedgerInfo const& info)
 }
 }  // namespace detail
 
+bool
+ReportingETL::decodeLedgerData(
+    ThreadSafeQueue<LedgerDataPage>& decodeQueue,
+    ThreadSafeQueue<std::optional<LedgerObjects>>& writeQueue)
+{
+    bool ok = true;
+    // keep draining the queue when stopping or after an error, so that the
+    // download is never blocked on a full queue
+    while (auto page = decodeQueue.pop())
+    {
+        if (stopping_ || !ok)
+            continue;
+
+        LedgerObjects objects;
+        objects.reserve(page->ledger_objects().objects_size());
+        for (auto& obj : page->ledger_objects().objects())
+        {
+            auto key = uint256::fromVoidChecked(obj.key());
+            if (!key)
+            {
+                JLOG(journal_.error()) << "Received malformed object ID";
+                ok = false;
+                break;
+            }
+
+            auto& data = obj.data();
+
+            SerialIter it{data.data(), data.size()};
+            objects.push_back(std::make_shared<SLE>(it, *key));
+        }
+
+        if (ok)
+            writeQueue.push(std::move(objects));
+    }
+    return ok;
+}
+
 void
 ReportingETL::consumeLedgerData(
     std::shared_ptr<Ledger>& ledger,
-    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue)
+    ThreadSafeQueue<LedgerDataPage> const& decodeQueue,
+    ThreadSafeQueue<std::optional<LedgerObjects>>& writeQueue)
 {
-    std::shared_ptr<SLE> sle;
+    using namespace std::chrono_literals;
+    auto const start = std::chrono::steady_clock::now();
+    auto lastReport = start;
     size_t num = 0;
-    while (!stopping_ && (sle = writeQueue.pop()))
+    size_t numPages = 0;
+    std::optional<LedgerObjects> objects;
+    // keep draining the queue when stopping, so that the decoders are never
+    // blocked on a full queue
+    while ((objects = writeQueue.pop()))
     {
-        assert(sle);
-        if (!ledger->exists(sle->key()))
-            ledger->rawInsert(sle);
+        if (stopping_)
+            continue;
 
-        if (flushInterval_ != 0 && (num % flushInterval_) == 0)
+        for (auto& sle : *objects)
         {
-            JLOG(journal_.debug()) << "Flushing! key = " << strHex(sle->key());
-            ledger->stateMap().flushDirty(hotACCOUNT_NODE);
+            assert(sle);
+            if (!ledger->exists(sle->key()))
+                ledger->rawInsert(sle);
+
+            if (flushInterval_ != 0 && (num % flushInterval_) == 0)
+            {
+                JLOG(journal_.debug())
+                    << "Flushing! key = " << strHex(sle->key());
+                ledger->stateMap().flushDirty(hotACCOUNT_NODE);
+            }
+            ++num;
+        }
+        ++numPages;
+
+        auto const now = std::chrono::steady_clock::now();
+        if (now - lastReport >= 10s)
+        {
+            lastReport = now;
+            auto const elapsed =
+                std::chrono::duration<double>(now - start).count();
+            // A backlog of pages to decode means the decoders are the
+            // bottleneck; a backlog of objects to write means this thread is
+            JLOG(journal_.info())
+                << "Initial ledger download: " << num << " objects in "
+                << numPages << " pages written. " << num / elapsed
+                << " objects per second. Pages waiting to be decoded = "
+                << decodeQueue.size()
+                << " . Pages waiting to be written = " << writeQueue.size();
         }
-        ++num;
     }
+
+    auto const elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    JLOG(journal_.info()) << "Initial ledger download wrote " << num
+                          << " objects in " << numPages << " pages. "
+                          << num / elapsed << " objects per second";
 }
 
 std::vector<AccountTransactionsData>
@@ -144,23 +219,53 @@ ReportingETL::loadInitialLedger(uint32_t startingSequence)
 
     auto start = std::chrono::system_clock::now();
 
-    ThreadSafeQueue<std::shared_ptr<SLE>> writeQueue;
-    std::thread asyncWriter{[this, &ledger, &writeQueue]() {
-        consumeLedgerData(ledger, writeQueue);
+    // Bound the queues so that a slow stage holds back the ones before it,
+    // rather than buffering the whole ledger in memory
+    auto const maxQueueSize = static_cast<uint32_t>(
+        4 * std::max(numMarkers_, numDecoders_));
+
+    ThreadSafeQueue<LedgerDataPage> decodeQueue{maxQueueSize};
+    ThreadSafeQueue<std::optional<LedgerObjects>> writeQueue{maxQueueSize};
+    std::thread asyncWriter{[this, &ledger, &decodeQueue, &writeQueue]() {
+        beast::setCurrentThreadName("rippled: ReportingETL write");
+        consumeLedgerData(ledger, decodeQueue, writeQueue);
     }};
 
+    std::atomic_bool malformed = false;
+    auto const numDecoders = std::max<size_t>(numDecoders_, 1);
+    std::vector<std::thread> decoders;
+    decoders.reserve(numDecoders);
+    while (decoders.size() < numDecoders)
+    {
+        decoders.emplace_back([this, &decodeQueue, &writeQueue, &malformed]() {
+            beast::setCurrentThreadName("rippled: ReportingETL decode");
+            if (!decodeLedgerData(decodeQueue, writeQueue))
+                malformed = true;
+        });
+    }
+
     // download the full account state map. This function downloads full ledger
-    // data and pushes the downloaded data into the writeQueue. asyncWriter
-    // consumes from the queue and inserts the data into the Ledger object.
-    // Once the below call returns, all data has been pushed into the queue
-    loadBalancer_.loadInitialLedger(startingSequence, writeQueue);
-
-    // null is used to represent the end of the queue
-    std::shared_ptr<SLE> null;
-    writeQueue.push(null);
+    // data and pushes the downloaded pages into the decodeQueue. The decoders
+    // deserialize the objects of each page and push them into the writeQueue.
+    // asyncWriter consumes from the writeQueue and inserts the data into the
+    // Ledger object. Once the below call returns, all data has been pushed
+    // into the decodeQueue
+    loadBalancer_.loadInitialLedger(startingSequence, decodeQueue);
+
+    // null is used to represent the end of the queue, once for each decoder
+    for (size_t i = 0; i < decoders.size(); ++i)
+        decodeQueue.push(nullptr);
+    for (auto& decoder : decoders)
+        decoder.join();
+
+    // an empty optional is used to represent the end of the queue
+    writeQueue.push({});
     // wait for the writer to finish
     asyncWriter.join();
 
+    if (malformed)
+        Throw<std::runtime_error>("Received malformed object ID");
+
     if (!stopping_)
     {
         flushLedger(ledger);
@@ -195,7 +300,7 @@ ReportingETL::flushLedger(std::shared_ptr<Ledger>& ledger)
     ledger->setImmutable(false);
     auto start = std::chrono::system_clock::now();
 
-    auto numFlushed = ledger->stateMap().flushDirty(hotACCOUNT_NODE);
+    auto numFlushed = ledger->stateMap().flushDirty(hotACCOUNT_NODE, true);
 
     auto numTxFlushed = ledger->txMap().flushDirty(hotTRANSACTION_NODE);
 
@@ -954,6 +1059,13 @@ ReportingETL::ReportingETL(Application& app)
                 numMarkers_,
                 *optNumMarkers,
                 "Expected integral num_markers config entry.  Got: ");
+
+        auto const optNumDecoders = section.get("num_decoders");
+        if (optNumDecoders)
+            asciiToIntThrows(
+                numDecoders_,
+                *optNumDecoders,
+                "Expected integral num_decoders config entry.  Got: ");
     }
 }
 
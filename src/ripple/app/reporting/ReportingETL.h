@@ -125,6 +125,12 @@ private:
     /// more load on the ETL source.
     size_t numMarkers_ = 2;
 
+    /// The number of threads which deserialize the ledger objects during the
+    /// initial ledger download. The pages downloaded by the numMarkers_ chains
+    /// of GetLedgerData calls are handed to these threads, which in turn hand
+    /// the objects to a single thread that inserts them into the ledger.
+    size_t numDecoders_ = 2;
+
     /// Whether the process is in strict read-only mode. In strict read-only
     /// mode, the process will never attempt to become the ETL writer, and will
     /// only publish ledgers as they are written to the database.
@@ -255,15 +261,29 @@ private:
     void
     publishLedger(std::shared_ptr<Ledger>& ledger);
 
+    /// Deserialize the ledger objects of downloaded pages
+    /// This function will continue to pull from the decode queue until the
+    /// queue returns nullptr. This is used during the initial ledger download
+    /// @param decodeQueue the queue with downloaded pages
+    /// @param writeQueue the queue to push the deserialized objects to
+    /// @return false if a page held a malformed object
+    bool
+    decodeLedgerData(
+        ThreadSafeQueue<LedgerDataPage>& decodeQueue,
+        ThreadSafeQueue<std::optional<LedgerObjects>>& writeQueue);
+
     /// Consume data from a queue and insert that data into the ledger
     /// This function will continue to pull from the queue until the queue
-    /// returns nullptr. This is used during the initial ledger download
+    /// returns an empty optional. This is used during the initial ledger
+    /// download
     /// @param ledger the ledger to insert data into
+    /// @param decodeQueue the queue with downloaded pages, for reporting
     /// @param writeQueue the queue with extracted data
     void
     consumeLedgerData(
         std::shared_ptr<Ledger>& ledger,
-        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue);
+        ThreadSafeQueue<LedgerDataPage> const& decodeQueue,
+        ThreadSafeQueue<std::optional<LedgerObjects>>& writeQueue);
 
 public:
     explicit ReportingETL(Application& app);
@@ -84,6 +84,12 @@ checkValidity(
     return {Validity::Valid, ""};
 }
 
+bool
+isSignatureCached(HashRouter& router, uint256 const& txid)
+{
+    return (router.getFlags(txid) & (SF_SIGBAD | SF_SIGGOOD)) != 0;
+}
+
 void
 forceValidity(HashRouter& router, uint256 const& txid, Validity validity)
 {
@@ -66,6 +66,14 @@ checkValidity(
     Rules const& rules,
     Config const& config);
 
+/** Checks whether the result of a signature check is already cached.
+
+    @return `true` if checkValidity will not need to verify the signature
+        of the transaction with this ID, because it is known good or bad.
+*/
+bool
+isSignatureCached(HashRouter& router, uint256 const& txid);
+
 /** Sets the validity of a given transaction in the cache.
 
     @warning Use with extreme care.
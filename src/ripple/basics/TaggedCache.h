@@ -25,8 +25,10 @@
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/insight/Insight.h>
+#include <algorithm>
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <type_traits>
@@ -43,6 +45,10 @@ namespace ripple {
     If it stays in memory even after it is ejected from the cache,
     the map will track it.
 
+    Each partition of the map has its own lock, so operations on keys in
+    different partitions do not contend, and sweeping only ever holds one
+    partition's lock for a small slice of that partition.
+
     @note Callers must not modify data objects that are stored in the cache
           unless they hold their own lock over all cache operations.
 */
@@ -72,6 +78,7 @@ public:
             beast::insight::NullCollector::New())
         : m_journal(journal)
         , m_clock(clock)
+        , m_mutex(std::make_unique<mutex_type[]>(m_cache.partitions()))
         , m_stats(
               name,
               std::bind(&TaggedCache::collect_metrics, this),
@@ -82,6 +89,7 @@ public:
         , m_cache_count(0)
         , m_hits(0)
         , m_misses(0)
+        , m_evictions(0)
     {
     }
 
@@ -97,20 +105,26 @@ public:
     std::size_t
     size() const
     {
-        std::lock_guard lock(m_mutex);
-        return m_cache.size();
+        std::size_t ret = 0;
+        for (std::size_t p = 0; p < m_cache.partitions(); ++p)
+        {
+            std::lock_guard lock(m_mutex[p]);
+            ret += m_cache.map()[p].size();
+        }
+        return ret;
     }
 
     void
     setTargetSize(int s)
     {
-        std::lock_guard lock(m_mutex);
         m_target_size = s;
 
         if (s > 0)
         {
-            for (auto& partition : m_cache.map())
+            for (std::size_t p = 0; p < m_cache.partitions(); ++p)
             {
+                std::lock_guard lock(m_mutex[p]);
+                auto& partition = m_cache.map()[p];
                 partition.rehash(static_cast<std::size_t>(
                     (s + (s >> 2)) /
                         (partition.max_load_factor() * m_cache.partitions()) +
@@ -124,55 +138,53 @@ public:
     clock_type::duration
     getTargetAge() const
     {
-        std::lock_guard lock(m_mutex);
         return m_target_age;
     }
 
     void
     setTargetAge(clock_type::duration s)
     {
-        std::lock_guard lock(m_mutex);
         m_target_age = s;
         JLOG(m_journal.debug())
-            << m_name << " target age set to " << m_target_age.count();
+            << m_name << " target age set to " << s.count();
     }
 
     int
     getCacheSize() const
     {
-        std::lock_guard lock(m_mutex);
         return m_cache_count;
     }
 
     int
     getTrackSize() const
     {
-        std::lock_guard lock(m_mutex);
-        return m_cache.size();
+        return size();
     }
 
     float
     getHitRate()
     {
-        std::lock_guard lock(m_mutex);
-        auto const total = static_cast<float>(m_hits + m_misses);
-        return m_hits * (100.0f / std::max(1.0f, total));
+        auto const hits = m_hits.load();
+        auto const total = static_cast<float>(hits + m_misses);
+        return hits * (100.0f / std::max(1.0f, total));
     }
 
     void
     clear()
     {
-        std::lock_guard lock(m_mutex);
-        m_cache.clear();
-        m_cache_count = 0;
+        for (std::size_t p = 0; p < m_cache.partitions(); ++p)
+        {
+            std::lock_guard lock(m_mutex[p]);
+            auto& partition = m_cache.map()[p];
+            m_cache_count -= cachedCount(partition);
+            partition.clear();
+        }
     }
 
     void
     reset()
     {
-        std::lock_guard lock(m_mutex);
-        m_cache.clear();
-        m_cache_count = 0;
+        clear();
         m_hits = 0;
         m_misses = 0;
     }
@@ -184,15 +196,13 @@ public:
     bool
     touch_if_exists(KeyComparable const& key)
     {
-        std::lock_guard lock(m_mutex);
-        auto const iter(m_cache.find(key));
-        if (iter == m_cache.end())
-        {
-            ++m_stats.misses;
+        auto const p = m_cache.partition(key);
+        std::lock_guard lock(m_mutex[p]);
+        auto& partition = m_cache.map()[p];
+        auto const iter(partition.find(key));
+        if (iter == partition.end())
             return false;
-        }
         iter->second.touch(m_clock.now());
-        ++m_stats.hits;
         return true;
     }
 
@@ -203,9 +213,8 @@ public:
     void
     sweep()
     {
-        // Keep references to all the stuff we sweep
-        // For performance, each worker thread should exit before the swept data
-        // is destroyed but still within the main cache lock.
+        // Keep references to all the stuff we sweep, so that it is destroyed
+        // after the partition locks have been released.
         std::vector<SweptPointersVector> allStuffToSweep(m_cache.partitions());
 
         clock_type::time_point const now(m_clock.now());
@@ -213,27 +222,27 @@ public:
 
         auto const start = std::chrono::steady_clock::now();
         {
-            std::lock_guard lock(m_mutex);
+            auto const tracked = size();
+            int const targetSize = m_target_size;
+            clock_type::duration const targetAge = m_target_age;
 
-            if (m_target_size == 0 ||
-                (static_cast<int>(m_cache.size()) <= m_target_size))
+            if (targetSize == 0 || (static_cast<int>(tracked) <= targetSize))
             {
-                when_expire = now - m_target_age;
+                when_expire = now - targetAge;
             }
             else
             {
-                when_expire =
-                    now - m_target_age * m_target_size / m_cache.size();
+                when_expire = now - targetAge * targetSize / tracked;
 
                 clock_type::duration const minimumAge(std::chrono::seconds(1));
                 if (when_expire > (now - minimumAge))
                     when_expire = now - minimumAge;
 
                 JLOG(m_journal.trace())
-                    << m_name << " is growing fast " << m_cache.size() << " of "
-                    << m_target_size << " aging at "
+                    << m_name << " is growing fast " << tracked << " of "
+                    << targetSize << " aging at "
                     << (now - when_expire).count() << " of "
-                    << m_target_age.count();
+                    << targetAge.count();
             }
 
             std::vector<std::thread> workers;
@@ -243,24 +252,20 @@ public:
             for (std::size_t p = 0; p < m_cache.partitions(); ++p)
             {
                 workers.push_back(sweepHelper(
-                    when_expire,
-                    now,
-                    m_cache.map()[p],
-                    allStuffToSweep[p],
-                    allRemovals,
-                    lock));
+                    when_expire, now, p, allStuffToSweep[p], allRemovals));
             }
             for (std::thread& worker : workers)
                 worker.join();
 
-            m_cache_count -= allRemovals;
+            m_evictions += allRemovals;
         }
-        // At this point allStuffToSweep will go out of scope outside the lock
+        // At this point allStuffToSweep will go out of scope outside the locks
         // and decrement the reference count on each strong pointer.
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        m_stats.sweep.notify(elapsed);
         JLOG(m_journal.debug())
-            << m_name << " TaggedCache sweep lock duration "
-            << std::chrono::duration_cast<std::chrono::milliseconds>(
-                   std::chrono::steady_clock::now() - start)
+            << m_name << " TaggedCache sweep duration "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
                    .count()
             << "ms";
     }
@@ -270,11 +275,13 @@ public:
     {
         // Remove from cache, if !valid, remove from map too. Returns true if
         // removed from cache
-        std::lock_guard lock(m_mutex);
+        auto const p = m_cache.partition(key);
+        std::lock_guard lock(m_mutex[p]);
+        auto& partition = m_cache.map()[p];
 
-        auto cit = m_cache.find(key);
+        auto cit = partition.find(key);
 
-        if (cit == m_cache.end())
+        if (cit == partition.end())
             return false;
 
         Entry& entry = cit->second;
@@ -289,7 +296,7 @@ public:
         }
 
         if (!valid || entry.isExpired())
-            m_cache.erase(cit);
+            partition.erase(cit);
 
         return ret;
     }
@@ -316,13 +323,15 @@ public:
     {
         // Return canonical value, store if needed, refresh in cache
         // Return values: true=we had the data already
-        std::lock_guard lock(m_mutex);
+        auto const p = m_cache.partition(key);
+        std::lock_guard lock(m_mutex[p]);
+        auto& partition = m_cache.map()[p];
 
-        auto cit = m_cache.find(key);
+        auto cit = partition.find(key);
 
-        if (cit == m_cache.end())
+        if (cit == partition.end())
         {
-            m_cache.emplace(
+            partition.emplace(
                 std::piecewise_construct,
                 std::forward_as_tuple(key),
                 std::forward_as_tuple(m_clock.now(), data));
@@ -395,8 +404,9 @@ public:
     std::shared_ptr<T>
     fetch(const key_type& key)
     {
-        std::lock_guard<mutex_type> l(m_mutex);
-        auto ret = initialFetch(key, l);
+        auto const p = m_cache.partition(key);
+        std::lock_guard<mutex_type> l(m_mutex[p]);
+        auto ret = initialFetch(key, m_cache.map()[p], l);
         if (!ret)
             ++m_misses;
         return ret;
@@ -419,9 +429,10 @@ public:
     auto
     insert(key_type const& key) -> std::enable_if_t<IsKeyCache, ReturnType>
     {
-        std::lock_guard lock(m_mutex);
+        auto const p = m_cache.partition(key);
+        std::lock_guard lock(m_mutex[p]);
         clock_type::time_point const now(m_clock.now());
-        auto [it, inserted] = m_cache.emplace(
+        auto [it, inserted] = m_cache.map()[p].emplace(
             std::piecewise_construct,
             std::forward_as_tuple(key),
             std::forward_as_tuple(now));
@@ -448,21 +459,16 @@ public:
         return true;
     }
 
-    mutex_type&
-    peekMutex()
-    {
-        return m_mutex;
-    }
-
     std::vector<key_type>
     getKeys() const
     {
         std::vector<key_type> v;
+        v.reserve(size());
 
+        for (std::size_t p = 0; p < m_cache.partitions(); ++p)
         {
-            std::lock_guard lock(m_mutex);
-            v.reserve(m_cache.size());
-            for (auto const& _ : m_cache)
+            std::lock_guard lock(m_mutex[p]);
+            for (auto const& _ : m_cache.map()[p])
                 v.push_back(_.first);
         }
 
@@ -474,11 +480,11 @@ public:
     double
     rate() const
     {
-        std::lock_guard lock(m_mutex);
-        auto const tot = m_hits + m_misses;
+        auto const hits = m_hits.load();
+        auto const tot = hits + m_misses;
         if (tot == 0)
             return 0;
-        return double(m_hits) / tot;
+        return double(hits) / tot;
     }
 
     /** Fetch an item from the cache.
@@ -490,9 +496,11 @@ public:
     std::shared_ptr<T>
     fetch(key_type const& digest, Handler const& h)
     {
+        auto const p = m_cache.partition(digest);
+        auto& partition = m_cache.map()[p];
         {
-            std::lock_guard l(m_mutex);
-            if (auto ret = initialFetch(digest, l))
+            std::lock_guard l(m_mutex[p]);
+            if (auto ret = initialFetch(digest, partition, l))
                 return ret;
         }
 
@@ -500,61 +508,16 @@ public:
         if (!sle)
             return {};
 
-        std::lock_guard l(m_mutex);
+        std::lock_guard l(m_mutex[p]);
         ++m_misses;
         auto const [it, inserted] =
-            m_cache.emplace(digest, Entry(m_clock.now(), std::move(sle)));
+            partition.emplace(digest, Entry(m_clock.now(), std::move(sle)));
         if (!inserted)
             it->second.touch(m_clock.now());
         return it->second.ptr;
     }
     // End CachedSLEs functions.
 
-private:
-    std::shared_ptr<T>
-    initialFetch(key_type const& key, std::lock_guard<mutex_type> const& l)
-    {
-        auto cit = m_cache.find(key);
-        if (cit == m_cache.end())
-            return {};
-
-        Entry& entry = cit->second;
-        if (entry.isCached())
-        {
-            ++m_hits;
-            entry.touch(m_clock.now());
-            return entry.ptr;
-        }
-        entry.ptr = entry.lock();
-        if (entry.isCached())
-        {
-            // independent of cache size, so not counted as a hit
-            ++m_cache_count;
-            entry.touch(m_clock.now());
-            return entry.ptr;
-        }
-
-        m_cache.erase(cit);
-        return {};
-    }
-
-    void
-    collect_metrics()
-    {
-        m_stats.size.set(getCacheSize());
-
-        {
-            beast::insight::Gauge::value_type hit_rate(0);
-            {
-                std::lock_guard lock(m_mutex);
-                auto const total(m_hits + m_misses);
-                if (total != 0)
-                    hit_rate = (m_hits * 100) / total;
-            }
-            m_stats.hit_rate.set(hit_rate);
-        }
-    }
-
 private:
     struct Stats
     {
@@ -566,17 +529,25 @@ private:
             : hook(collector->make_hook(handler))
             , size(collector->make_gauge(prefix, "size"))
             , hit_rate(collector->make_gauge(prefix, "hit_rate"))
-            , hits(0)
-            , misses(0)
+            , hits(collector->make_counter(prefix, "hits"))
+            , misses(collector->make_counter(prefix, "misses"))
+            , evictions(collector->make_counter(prefix, "evictions"))
+            , sweep(collector->make_event(prefix, "sweep"))
         {
         }
 
         beast::insight::Hook hook;
         beast::insight::Gauge size;
         beast::insight::Gauge hit_rate;
-
-        std::size_t hits;
-        std::size_t misses;
+        beast::insight::Counter hits;
+        beast::insight::Counter misses;
+        beast::insight::Counter evictions;
+        beast::insight::Event sweep;
+
+        // Totals already reported, only used by collect_metrics
+        std::uint64_t reportedHits = 0;
+        std::uint64_t reportedMisses = 0;
+        std::uint64_t reportedEvictions = 0;
     };
 
     class KeyOnlyEntry
@@ -641,82 +612,176 @@ private:
         typename std::conditional<IsKeyCache, KeyOnlyEntry, ValueEntry>::type
             Entry;
 
-    using KeyOnlyCacheType =
-        hardened_partitioned_hash_map<key_type, KeyOnlyEntry, Hash, KeyEqual>;
-
-    using KeyValueCacheType =
-        hardened_partitioned_hash_map<key_type, ValueEntry, Hash, KeyEqual>;
-
     using cache_type =
         hardened_partitioned_hash_map<key_type, Entry, Hash, KeyEqual>;
 
+    using partition_type = typename cache_type::map_type;
+
+    std::shared_ptr<T>
+    initialFetch(
+        key_type const& key,
+        partition_type& partition,
+        std::lock_guard<mutex_type> const&)
+    {
+        auto cit = partition.find(key);
+        if (cit == partition.end())
+            return {};
+
+        Entry& entry = cit->second;
+        if (entry.isCached())
+        {
+            ++m_hits;
+            entry.touch(m_clock.now());
+            return entry.ptr;
+        }
+        entry.ptr = entry.lock();
+        if (entry.isCached())
+        {
+            // independent of cache size, so not counted as a hit
+            ++m_cache_count;
+            entry.touch(m_clock.now());
+            return entry.ptr;
+        }
+
+        partition.erase(cit);
+        return {};
+    }
+
+    // Number of strongly cached entries in a partition
+    static int
+    cachedCount(partition_type const& partition)
+    {
+        if constexpr (IsKeyCache)
+            return 0;
+        else
+            return static_cast<int>(std::count_if(
+                partition.begin(), partition.end(), [](auto const& e) {
+                    return e.second.isCached();
+                }));
+    }
+
+    void
+    collect_metrics()
+    {
+        m_stats.size.set(getCacheSize());
+
+        {
+            beast::insight::Gauge::value_type hit_rate(0);
+            {
+                auto const hits = m_hits.load();
+                auto const total(hits + m_misses);
+                if (total != 0)
+                    hit_rate = (hits * 100) / total;
+            }
+            m_stats.hit_rate.set(hit_rate);
+        }
+
+        // Report activity since the last collection. The totals restart
+        // from zero when the cache is reset.
+        auto const report = [](beast::insight::Counter const& counter,
+                               std::uint64_t total,
+                               std::uint64_t& reported) {
+            counter.increment(total >= reported ? total - reported : total);
+            reported = total;
+        };
+        report(m_stats.hits, m_hits, m_stats.reportedHits);
+        report(m_stats.misses, m_misses, m_stats.reportedMisses);
+        report(m_stats.evictions, m_evictions, m_stats.reportedEvictions);
+    }
+
+    // Number of buckets of a partition swept under one acquisition of the
+    // partition's lock
+    static constexpr std::size_t sweepSliceBuckets = 1024;
+
     [[nodiscard]] std::thread
     sweepHelper(
         clock_type::time_point const& when_expire,
         [[maybe_unused]] clock_type::time_point const& now,
-        typename KeyValueCacheType::map_type& partition,
+        std::size_t p,
         SweptPointersVector& stuffToSweep,
-        std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&)
+        std::atomic<int>& allRemovals)
     {
-        return std::thread([&, this]() {
+        return std::thread([&, p, this]() {
             int cacheRemovals = 0;
             int mapRemovals = 0;
 
-            // Keep references to all the stuff we sweep
-            // so that we can destroy them outside the lock.
-            stuffToSweep.first.reserve(partition.size());
-            stuffToSweep.second.reserve(partition.size());
+            auto& partition = m_cache.map()[p];
+            std::vector<key_type> toErase;
+            std::size_t remaining = 0;
+
+            // Walk the partition a slice of buckets at a time, releasing the
+            // lock in between. Should the partition rehash between slices,
+            // some entries may be examined twice or not at all; they are
+            // handled correctly either way, or left for the next sweep.
+            for (std::size_t first = 0;; first += sweepSliceBuckets)
             {
-                auto cit = partition.begin();
-                while (cit != partition.end())
+                std::lock_guard lock(m_mutex[p]);
+
+                auto const buckets = partition.bucket_count();
+                if (first >= buckets)
                 {
-                    if (cit->second.isWeak())
+                    // Read under the lock; other threads may change the
+                    // partition as soon as it is released.
+                    remaining = partition.size();
+                    break;
+                }
+                auto const last = std::min(first + sweepSliceBuckets, buckets);
+
+                for (auto b = first; b != last; ++b)
+                {
+                    for (auto cit = partition.begin(b);
+                         cit != partition.end(b);
+                         ++cit)
                     {
-                        // weak
-                        if (cit->second.isExpired())
+                        if constexpr (IsKeyCache)
                         {
-                            stuffToSweep.second.push_back(
-                                std::move(cit->second.weak_ptr));
-                            ++mapRemovals;
-                            cit = partition.erase(cit);
+                            if (cit->second.last_access > now)
+                                cit->second.last_access = now;
+                            else if (cit->second.last_access <= when_expire)
+                                toErase.push_back(cit->first);
                         }
-                        else
+                        else if (cit->second.isWeak())
                         {
-                            ++cit;
+                            // weak
+                            if (cit->second.isExpired())
+                            {
+                                stuffToSweep.second.push_back(
+                                    std::move(cit->second.weak_ptr));
+                                ++mapRemovals;
+                                toErase.push_back(cit->first);
+                            }
                         }
-                    }
-                    else if (cit->second.last_access <= when_expire)
-                    {
-                        // strong, expired
-                        ++cacheRemovals;
-                        if (cit->second.ptr.use_count() == 1)
-                        {
-                            stuffToSweep.first.push_back(
-                                std::move(cit->second.ptr));
-                            ++mapRemovals;
-                            cit = partition.erase(cit);
-                        }
-                        else
+                        else if (cit->second.last_access <= when_expire)
                         {
-                            // remains weakly cached
-                            cit->second.ptr.reset();
-                            ++cit;
+                            // strong, expired
+                            ++cacheRemovals;
+                            --m_cache_count;
+                            if (cit->second.ptr.use_count() == 1)
+                            {
+                                stuffToSweep.first.push_back(
+                                    std::move(cit->second.ptr));
+                                ++mapRemovals;
+                                toErase.push_back(cit->first);
+                            }
+                            else
+                            {
+                                // remains weakly cached
+                                cit->second.ptr.reset();
+                            }
                         }
                     }
-                    else
-                    {
-                        // strong, not expired
-                        ++cit;
-                    }
                 }
+
+                for (auto const& key : toErase)
+                    partition.erase(key);
+                toErase.clear();
             }
 
             if (mapRemovals || cacheRemovals)
             {
                 JLOG(m_journal.debug())
                     << "TaggedCache partition sweep " << m_name
-                    << ": cache = " << partition.size() << "-" << cacheRemovals
+                    << ": cache = " << remaining << "-" << cacheRemovals
                     << ", map-=" << mapRemovals;
             }
 
@@ -724,73 +789,30 @@ private:
         });
     }
 
-    [[nodiscard]] std::thread
-    sweepHelper(
-        clock_type::time_point const& when_expire,
-        clock_type::time_point const& now,
-        typename KeyOnlyCacheType::map_type& partition,
-        SweptPointersVector&,
-        std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&)
-    {
-        return std::thread([&, this]() {
-            int cacheRemovals = 0;
-            int mapRemovals = 0;
-
-            // Keep references to all the stuff we sweep
-            // so that we can destroy them outside the lock.
-            {
-                auto cit = partition.begin();
-                while (cit != partition.end())
-                {
-                    if (cit->second.last_access > now)
-                    {
-                        cit->second.last_access = now;
-                        ++cit;
-                    }
-                    else if (cit->second.last_access <= when_expire)
-                    {
-                        cit = partition.erase(cit);
-                    }
-                    else
-                    {
-                        ++cit;
-                    }
-                }
-            }
+    beast::Journal m_journal;
+    clock_type& m_clock;
 
-            if (mapRemovals || cacheRemovals)
-            {
-                JLOG(m_journal.debug())
-                    << "TaggedCache partition sweep " << m_name
-                    << ": cache = " << partition.size() << "-" << cacheRemovals
-                    << ", map-=" << mapRemovals;
-            }
+    cache_type m_cache;  // Hold strong reference to recent objects
 
-            allRemovals += cacheRemovals;
-        });
-    };
+    // One lock for each partition of m_cache
+    std::unique_ptr<mutex_type[]> const m_mutex;
 
-    beast::Journal m_journal;
-    clock_type& m_clock;
     Stats m_stats;
 
-    mutex_type mutable m_mutex;
-
     // Used for logging
     std::string m_name;
 
     // Desired number of cache entries (0 = ignore)
-    int m_target_size;
+    std::atomic<int> m_target_size;
 
     // Desired maximum cache age
-    clock_type::duration m_target_age;
+    std::atomic<clock_type::duration> m_target_age;
 
     // Number of items cached
-    int m_cache_count;
-    cache_type m_cache;  // Hold strong reference to recent objects
-    std::uint64_t m_hits;
-    std::uint64_t m_misses;
+    std::atomic<int> m_cache_count;
+    std::atomic<std::uint64_t> m_hits;
+    std::atomic<std::uint64_t> m_misses;
+    std::atomic<std::uint64_t> m_evictions;
 };
 
 }  // namespace ripple
@@ -261,6 +261,19 @@ public:
         return map_;
     }
 
+    partition_map_type const&
+    map() const
+    {
+        return map_;
+    }
+
+    /** Return the index of the partition which holds the key. */
+    std::size_t
+    partition(key_type const& key) const
+    {
+        return partitioner(key);
+    }
+
     iterator
     begin()
     {
@@ -344,6 +344,19 @@ class Validations
     // Set of ledgers being acquired from the network
     hash_map<std::pair<Seq, ID>, hash_set<NodeID>> acquiring_;
 
+    // Trusted validations accepted by add() but not yet reflected in the
+    // trie. These are merged as a batch the next time the trie, lastLedger_
+    // or acquiring_ are used, so that ledgers still being acquired are
+    // looked up once per batch rather than once per validation. The merge
+    // still runs under mutex_.
+    struct PendingTrie
+    {
+        NodeID nodeID;
+        Validation val;
+        std::optional<std::pair<Seq, ID>> prior;
+    };
+    std::vector<PendingTrie> pending_;
+
     // Parameters to determine validation staleness
     ValidationParms const parms_;
 
@@ -426,6 +439,8 @@ private:
         @param val The trusted validation issued by the node
         @param prior If not none, the last current validated ledger Seq,ID of
                      key
+
+        @note Callers are expected to have called checkAcquired beforehand.
     */
     void
     updateTrie(
@@ -448,8 +463,6 @@ private:
             }
         }
 
-        checkAcquired(lock);
-
         std::pair<Seq, ID> valPair{val.seq(), val.ledgerID()};
         auto it = acquiring_.find(valPair);
         if (it != acquiring_.end())
@@ -465,6 +478,26 @@ private:
         }
     }
 
+    /** Merge pending trusted validations into the trie
+
+        Applies the validations queued by add() in the order they were
+        accepted. Pending acquisitions are checked once for the whole batch
+        rather than once per validation.
+
+        @param lock Existing lock of mutex_
+    */
+    void
+    mergePending(std::lock_guard<Mutex> const& lock)
+    {
+        if (pending_.empty())
+            return;
+
+        checkAcquired(lock);
+        for (auto const& p : pending_)
+            updateTrie(lock, p.nodeID, p.val, p.prior);
+        pending_.clear();
+    }
+
     /** Use the trie for a calculation
 
         Accessing the trie through this helper ensures acquiring validations
@@ -508,6 +541,10 @@ private:
     void
     current(std::lock_guard<Mutex> const& lock, Pre&& pre, F&& f)
     {
+        // Stale validations are removed from the trie below, so it must
+        // reflect every validation accepted so far
+        mergePending(lock);
+
         NetClock::time_point t = adaptor_.now();
         pre(current_.size());
         auto it = current_.begin();
@@ -612,7 +649,8 @@ public:
 
     /** Add a new validation
 
-        Attempt to add a new validation.
+        Attempt to add a new validation. Trusted validations are reflected
+        in the trie lazily, the next time it is consulted.
 
         @param nodeID The identity of the node issuing this validation
         @param val The validation to store
@@ -690,14 +728,14 @@ public:
                     std::pair<Seq, ID> old(oldVal.seq(), oldVal.ledgerID());
                     it->second = val;
                     if (val.trusted())
-                        updateTrie(lock, nodeID, val, old);
+                        pending_.push_back({nodeID, val, old});
                 }
                 else
                     return ValStatus::stale;
             }
             else if (val.trusted())
             {
-                updateTrie(lock, nodeID, val, std::nullopt);
+                pending_.push_back({nodeID, val, std::nullopt});
             }
         }
 
@@ -793,6 +831,8 @@ public:
     {
         std::lock_guard lock{mutex_};
 
+        mergePending(lock);
+        checkAcquired(lock);
         for (auto& [nodeId, validation] : current_)
         {
             if (added.find(nodeId) != added.end())
@@ -825,9 +865,10 @@ public:
     }
 
     Json::Value
-    getJsonTrie() const
+    getJsonTrie()
     {
         std::lock_guard lock{mutex_};
+        mergePending(lock);
         return trie_.getJson();
     }
 
@@ -971,6 +1012,7 @@ public:
     getNodesAfter(Ledger const& ledger, ID const& ledgerID)
     {
         std::lock_guard lock{mutex_};
+        mergePending(lock);
 
         // Use trie if ledger is the right one
         if (ledger.id() == ledgerID)
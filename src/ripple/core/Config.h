@@ -206,6 +206,8 @@ public:
     int PATH_SEARCH = 2;
     int PATH_SEARCH_FAST = 2;
     int PATH_SEARCH_MAX = 3;
+    // The most threads one path search may use to rank its candidate paths.
+    int PATH_SEARCH_THREADS = 2;
 
     // Validation
     std::optional<std::size_t>
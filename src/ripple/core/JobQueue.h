@@ -29,6 +29,8 @@
 #include <boost/coroutine/all.hpp>
 #include <boost/range/begin.hpp>  // workaround for boost 1.72 bug
 #include <boost/range/end.hpp>    // workaround for boost 1.72 bug
+#include <deque>
+#include <functional>
 
 namespace ripple {
 
@@ -244,8 +246,16 @@ private:
 
     beast::Journal m_journal;
     mutable std::mutex m_mutex;
-    std::uint64_t m_lastJob;
-    std::set<Job> m_jobSet;
+    std::atomic<std::uint64_t> m_lastJob;
+
+    // The waiting jobs of each type, in the order they were added. The map
+    // is ordered from the highest priority type to the lowest, so a job can
+    // be picked without visiting the jobs of types already at their limit.
+    std::map<JobType, std::deque<Job>, std::greater<JobType>> m_jobQueues;
+
+    // The total number of waiting jobs
+    std::size_t m_jobCount = 0;
+
     JobCounter jobCounter_;
     std::atomic_bool stopping_{false};
     std::atomic_bool stopped_{false};
@@ -290,15 +300,15 @@ private:
     // Returns the next Job we should run now.
     //
     // RunnableJob:
-    //  A Job in the JobSet whose slots count for its type is greater than zero.
+    //  A waiting Job whose slots count for its type is greater than zero.
     //
     // Pre-conditions:
-    //  mJobSet must not be empty.
-    //  mJobSet holds at least one RunnableJob
+    //  m_jobQueues must not be empty.
+    //  m_jobQueues holds at least one RunnableJob
     //
     // Post-conditions:
     //  job is a valid Job object.
-    //  job is removed from mJobQueue.
+    //  job is removed from m_jobQueues.
     //  Waiting job count of its type is decremented
     //  Running job count of its type is incremented
     //
@@ -310,7 +320,7 @@ private:
     // Indicates that a running Job has completed its task.
     //
     // Pre-conditions:
-    //  Job must not exist in mJobSet.
+    //  Job must not exist in m_jobQueues.
     //  The JobType must not be invalid.
     //
     // Post-conditions:
@@ -326,7 +336,7 @@ private:
     // Runs the next appropriate waiting Job.
     //
     // Pre-conditions:
-    //  A RunnableJob must exist in the JobSet
+    //  A RunnableJob must exist in m_jobQueues
     //
     // Post-conditions:
     //  The chosen RunnableJob will have Job::doJob() called.
@@ -654,6 +654,15 @@ Config::loadFromString(std::string const& fileContents)
         PATH_SEARCH_FAST = beast::lexicalCastThrow<int>(strTemp);
     if (getSingleSection(secConfig, SECTION_PATH_SEARCH_MAX, strTemp, j_))
         PATH_SEARCH_MAX = beast::lexicalCastThrow<int>(strTemp);
+    if (getSingleSection(secConfig, SECTION_PATH_SEARCH_THREADS, strTemp, j_))
+    {
+        PATH_SEARCH_THREADS = beast::lexicalCastThrow<int>(strTemp);
+
+        if (PATH_SEARCH_THREADS < 1 || PATH_SEARCH_THREADS > 64)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_PATH_SEARCH_THREADS
+                ": must be between 1 and 64 inclusive.");
+    }
 
     if (getSingleSection(secConfig, SECTION_DEBUG_LOGFILE, strTemp, j_))
         DEBUG_LOGFILE = strTemp;
@@ -57,6 +57,8 @@ JobQueue::JobQueue(
                 std::forward_as_tuple(jt, m_collector, logs)));
             assert(result.second == true);
             (void)result.second;
+
+            m_jobQueues[jt.type()];
         }
     }
 }
@@ -71,7 +73,7 @@ void
 JobQueue::collect()
 {
     std::lock_guard lock(m_mutex);
-    job_count = m_jobSet.size();
+    job_count = m_jobCount;
 }
 
 bool
@@ -97,19 +99,17 @@ JobQueue::addRefCountedJob(
         (type >= jtCLIENT && type <= jtCLIENT_WEBSOCKET) ||
         m_workers.getNumberOfThreads() > 0);
 
+    // Build the job before taking the lock, it allocates
+    Job job(type, name, ++m_lastJob, data.load(), func);
+
     {
         std::lock_guard lock(m_mutex);
-        auto result =
-            m_jobSet.emplace(type, name, ++m_lastJob, data.load(), func);
-        auto const& job = *result.first;
-
-        JobType const type(job.getType());
-        assert(type != jtINVALID);
-        assert(m_jobSet.find(job) != m_jobSet.end());
+        auto const queue = m_jobQueues.find(type);
+        assert(queue != m_jobQueues.end());
+        queue->second.push_back(std::move(job));
+        ++m_jobCount;
         perfLog_.jobQueue(type);
 
-        JobTypeData& data(getJobTypeData(type));
-
         if (data.waiting + data.running < getJobLimit(type))
         {
             m_workers.addTask();
@@ -254,7 +254,7 @@ void
 JobQueue::rendezvous()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobCount == 0; });
 }
 
 JobTypeData&
@@ -285,9 +285,9 @@ JobQueue::stop()
         // we must wait on the condition variable to make these assertions.
         std::unique_lock<std::mutex> lock(m_mutex);
         cv_.wait(
-            lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+            lock, [this] { return m_processCount == 0 && m_jobCount == 0; });
         assert(m_processCount == 0);
-        assert(m_jobSet.empty());
+        assert(m_jobCount == 0);
         assert(nSuspend_ == 0);
         stopped_ = true;
     }
@@ -302,12 +302,13 @@ JobQueue::isStopped() const
 void
 JobQueue::getNextJob(Job& job)
 {
-    assert(!m_jobSet.empty());
+    assert(m_jobCount != 0);
 
-    std::set<Job>::const_iterator iter;
-    for (iter = m_jobSet.begin(); iter != m_jobSet.end(); ++iter)
+    for (auto& [type, queue] : m_jobQueues)
     {
-        JobType const type = iter->getType();
+        if (queue.empty())
+            continue;
+
         assert(type != jtINVALID);
 
         JobTypeData& data(getJobTypeData(type));
@@ -319,13 +320,15 @@ JobQueue::getNextJob(Job& job)
             assert(data.waiting > 0);
             --data.waiting;
             ++data.running;
-            break;
+
+            job = std::move(queue.front());
+            queue.pop_front();
+            --m_jobCount;
+            return;
         }
     }
 
-    assert(iter != m_jobSet.end());
-    job = *iter;
-    m_jobSet.erase(iter);
+    assert(false);
 }
 
 void
@@ -392,7 +395,7 @@ JobQueue::processTask(int instance)
         // otherwise destructors with side effects can access
         // parent objects that are already destroyed.
         finishJob(type);
-        if (--m_processCount == 0 && m_jobSet.empty())
+        if (--m_processCount == 0 && m_jobCount == 0)
             cv_.notify_all();
     }
 
@@ -23,6 +23,9 @@
 #include <ripple/json/json_writer.h>
 #include <ripple/json/to_string.h>
 
+#include <algorithm>
+#include <memory>
+
 namespace Json {
 
 const Value Value::null;
@@ -165,6 +168,210 @@ Value::CZString::isStaticString() const
     return index_ == noDuplication;
 }
 
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class Value::ObjectValues
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+Value::ObjectValues::ObjectValues(ObjectValues const& other) : ObjectValues()
+{
+    // Once the delegated constructor has run, the destructor releases
+    // whatever was copied if a later member throws.
+    bool const inTree = !other.tree_.empty();
+    if (!inTree)
+        index_.reserve(other.index_.size());
+    for (auto const& member : other)
+    {
+        auto slot = allocate();
+        value_type* copied = nullptr;
+        try
+        {
+            copied = new (slot) value_type(member);
+            if (inTree)
+                tree_.insert(tree_.end(), copied);
+            else
+                index_.push_back(copied);
+        }
+        catch (...)
+        {
+            if (copied)
+                std::destroy_at(copied);
+            free_.push_back(slot);
+            throw;
+        }
+    }
+}
+
+Value::ObjectValues::~ObjectValues()
+{
+    clear();
+}
+
+void*
+Value::ObjectValues::allocate()
+{
+    if (!free_.empty())
+    {
+        auto slot = free_.back();
+        free_.pop_back();
+        return slot;
+    }
+
+    if (chunks_.empty() && used_ < inlineSlots)
+        return inline_ + sizeof(value_type) * used_++;
+
+    if (chunks_.empty() || used_ == chunks_.back().second)
+    {
+        std::size_t const slots = chunks_.empty()
+            ? 2 * inlineSlots
+            : std::min(2 * chunks_.back().second, maxChunkSlots);
+        chunks_.reserve(chunks_.size() + 1);
+        chunks_.emplace_back(
+            std::allocator<value_type>{}.allocate(slots), slots);
+        used_ = 0;
+    }
+
+    return chunks_.back().first + used_++;
+}
+
+Value::ObjectValues::const_iterator
+Value::ObjectValues::lower_bound(CZString const& key) const
+{
+    if (!tree_.empty())
+        return const_iterator(tree_.lower_bound(key));
+
+    // Arrays are almost always built by appending.
+    if (index_.empty() || index_.back()->first < key)
+        return end();
+
+    auto const it = std::lower_bound(
+        index_.begin(),
+        index_.end(),
+        key,
+        [](value_type const* member, CZString const& k) {
+            return member->first < k;
+        });
+    return const_iterator(index_.data() + (it - index_.begin()));
+}
+
+Value::ObjectValues::const_iterator
+Value::ObjectValues::find(CZString const& key) const
+{
+    auto const it = lower_bound(key);
+    if (it != end() && it->first == key)
+        return it;
+    return end();
+}
+
+Value::ObjectValues::iterator
+Value::ObjectValues::insert(const_iterator hint, value_type const& member)
+{
+    auto slot = allocate();
+    value_type* inserted = nullptr;
+    try
+    {
+        inserted = new (slot) value_type(member);
+
+        if (!tree_.empty())
+            return iterator(tree_.insert(hint.t_, inserted));
+
+        if (index_.size() < flatLimit)
+        {
+            auto const pos = hint.p_ - index_.data();
+            index_.insert(index_.begin() + pos, inserted);
+            return iterator(index_.data() + pos);
+        }
+
+        // Inserting into the middle of a large vector is linear, so a big
+        // object built in descending key order would be quadratic. Move
+        // the members into a tree instead; the sorted index builds it in
+        // linear time.
+        Tree tree(index_.begin(), index_.end());
+        auto const it = tree.insert(inserted).first;
+        tree_.swap(tree);
+        index_.clear();
+        return iterator(it);
+    }
+    catch (...)
+    {
+        if (inserted)
+            std::destroy_at(inserted);
+        free_.push_back(slot);
+        throw;
+    }
+}
+
+void
+Value::ObjectValues::erase(const_iterator it)
+{
+    // Record the slot as free first: that is the only step which can throw,
+    // and growing free_ geometrically keeps a run of erases linear.
+    value_type* const member = it.inTree_ ? *it.t_ : *it.p_;
+    free_.push_back(member);
+    if (it.inTree_)
+        tree_.erase(it.t_);
+    else
+        index_.erase(index_.begin() + (it.p_ - index_.data()));
+    std::destroy_at(member);
+}
+
+void
+Value::ObjectValues::clear()
+{
+    for (auto member : index_)
+        std::destroy_at(member);
+    for (auto member : tree_)
+        std::destroy_at(member);
+    index_.clear();
+    tree_.clear();
+    free_.clear();
+    for (auto const& [slots, count] : chunks_)
+        std::allocator<value_type>{}.deallocate(slots, count);
+    chunks_.clear();
+    used_ = 0;
+}
+
+std::ptrdiff_t
+Value::ObjectValues::distance(const_iterator first, const_iterator last)
+{
+    if (first.inTree_)
+        return std::distance(first.t_, last.t_);
+    return last.p_ - first.p_;
+}
+
+bool
+operator==(Value::ObjectValues const& x, Value::ObjectValues const& y)
+{
+    return std::equal(
+        x.begin(),
+        x.end(),
+        y.begin(),
+        y.end(),
+        [](auto const& a, auto const& b) {
+            return a.first == b.first && a.second == b.second;
+        });
+}
+
+bool
+operator<(Value::ObjectValues const& x, Value::ObjectValues const& y)
+{
+    return std::lexicographical_compare(
+        x.begin(),
+        x.end(),
+        y.begin(),
+        y.end(),
+        [](auto const& a, auto const& b) {
+            if (a.first < b.first)
+                return true;
+            if (b.first < a.first)
+                return false;
+            return a.second < b.second;
+        });
+}
+
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
@@ -63,28 +63,15 @@ ValueIteratorBase::difference_type
 ValueIteratorBase::computeDistance(const SelfType& other) const
 {
     // Iterator for null value are initialized using the default
-    // constructor, which initialize current_ to the default
-    // std::map::iterator. As begin() and end() are two instance
-    // of the default std::map::iterator, they can not be compared.
-    // To allow this, we handle this comparison specifically.
+    // constructor, which does not refer to any container, so two of them can
+    // only be compared with each other.
     if (isNull_ && other.isNull_)
     {
         return 0;
     }
 
-    // Usage of std::distance is not portable (does not compile with Sun Studio
-    // 12 RogueWave STL, which is the one used by default). Using a portable
-    // hand-made version for non random iterator instead:
-    //   return difference_type( std::distance( current_, other.current_ ) );
-    difference_type myDistance = 0;
-
-    for (Value::ObjectValues::iterator it = current_; it != other.current_;
-         ++it)
-    {
-        ++myDistance;
-    }
-
-    return myDistance;
+    return difference_type(
+        Value::ObjectValues::distance(current_, other.current_));
 }
 
 bool
@@ -21,9 +21,15 @@
 #define RIPPLE_JSON_JSON_VALUE_H_INCLUDED
 
 #include <ripple/json/json_forwards.h>
+#include <boost/container/small_vector.hpp>
+#include <cstddef>
 #include <cstring>
+#include <iterator>
 #include <map>
+#include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /** \brief JSON (JavaScript Object Notation).
@@ -191,7 +197,7 @@ private:
     };
 
 public:
-    using ObjectValues = std::map<CZString, Value>;
+    class ObjectValues;
 
 public:
     /** \brief Create a default Value of the given type.
@@ -433,6 +439,266 @@ private:
     int allocated_ : 1;  // Notes: if declared as bool, bitfield is useless.
 };
 
+/** Storage for the members of an array or object.
+
+    Small objects find their members through a vector of pointers kept sorted
+    by key, so a lookup is a binary search over contiguous memory and
+    appending to an array is a push_back. Once an object grows past
+    flatLimit members the pointers move into a balanced tree, so that
+    inserting keys in any order stays logarithmic however large the object
+    gets. The tree is only left again when the object becomes empty.
+
+    The members themselves live in slots that never move: the first few are
+    inside this object and the rest are in chunks which grow geometrically.
+    A reference to a member stays valid until that member is removed, as it
+    did with std::map, while a typical object is built with one or two
+    allocations instead of one per member.
+
+    Slots released by erase() are reused by later inserts. Iterators are
+    invalidated by insert() and erase().
+*/
+class Value::ObjectValues
+{
+public:
+    using value_type = std::pair<const CZString, Value>;
+
+private:
+    struct KeyLess
+    {
+        using is_transparent = void;
+
+        bool
+        operator()(value_type const* a, value_type const* b) const
+        {
+            return a->first < b->first;
+        }
+
+        bool
+        operator()(value_type const* a, CZString const& b) const
+        {
+            return a->first < b;
+        }
+
+        bool
+        operator()(CZString const& a, value_type const* b) const
+        {
+            return a < b->first;
+        }
+    };
+
+    using Tree = std::set<value_type*, KeyLess>;
+
+public:
+    template <bool IsConst>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ObjectValues::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer =
+            std::conditional_t<IsConst, value_type const*, value_type*>;
+        using reference =
+            std::conditional_t<IsConst, value_type const&, value_type&>;
+
+        basic_iterator() = default;
+
+        // An iterator converts to a const_iterator, but not the reverse.
+        template <
+            bool OtherConst,
+            class = std::enable_if_t<IsConst && !OtherConst>>
+        basic_iterator(basic_iterator<OtherConst> const& other)
+            : p_(other.p_), t_(other.t_), inTree_(other.inTree_)
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return *get();
+        }
+
+        pointer
+        operator->() const
+        {
+            return get();
+        }
+
+        basic_iterator&
+        operator++()
+        {
+            if (inTree_)
+                ++t_;
+            else
+                ++p_;
+            return *this;
+        }
+
+        basic_iterator&
+        operator--()
+        {
+            if (inTree_)
+                --t_;
+            else
+                --p_;
+            return *this;
+        }
+
+        friend bool
+        operator==(basic_iterator const& lhs, basic_iterator const& rhs)
+        {
+            if (lhs.inTree_ != rhs.inTree_)
+                return false;
+            return lhs.inTree_ ? lhs.t_ == rhs.t_ : lhs.p_ == rhs.p_;
+        }
+
+        friend bool
+        operator!=(basic_iterator const& lhs, basic_iterator const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template <bool>
+        friend class basic_iterator;
+        friend class ObjectValues;
+
+        explicit basic_iterator(value_type* const* p) : p_(p)
+        {
+        }
+
+        explicit basic_iterator(Tree::const_iterator t)
+            : t_(t), inTree_(true)
+        {
+        }
+
+        pointer
+        get() const
+        {
+            return inTree_ ? *t_ : *p_;
+        }
+
+        value_type* const* p_ = nullptr;
+        Tree::const_iterator t_{};
+        bool inTree_ = false;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    ObjectValues() = default;
+    ObjectValues(ObjectValues const& other);
+    ObjectValues&
+    operator=(ObjectValues const&) = delete;
+    ~ObjectValues();
+
+    const_iterator
+    begin() const
+    {
+        return tree_.empty() ? const_iterator(index_.data())
+                             : const_iterator(tree_.begin());
+    }
+
+    iterator
+    begin()
+    {
+        return toMutable(std::as_const(*this).begin());
+    }
+
+    const_iterator
+    end() const
+    {
+        return tree_.empty() ? const_iterator(index_.data() + index_.size())
+                             : const_iterator(tree_.end());
+    }
+
+    iterator
+    end()
+    {
+        return toMutable(std::as_const(*this).end());
+    }
+
+    std::size_t
+    size() const
+    {
+        return tree_.empty() ? index_.size() : tree_.size();
+    }
+
+    bool
+    empty() const
+    {
+        return index_.empty() && tree_.empty();
+    }
+
+    /** Return the first member whose key is not less than `key`. */
+    const_iterator
+    lower_bound(CZString const& key) const;
+
+    iterator
+    lower_bound(CZString const& key)
+    {
+        return toMutable(std::as_const(*this).lower_bound(key));
+    }
+
+    const_iterator
+    find(CZString const& key) const;
+
+    iterator
+    find(CZString const& key)
+    {
+        return toMutable(std::as_const(*this).find(key));
+    }
+
+    /** Insert a member at `hint`, which must come from lower_bound(). */
+    iterator
+    insert(const_iterator hint, value_type const& member);
+
+    void
+    erase(const_iterator it);
+
+    void
+    clear();
+
+    /** Return the number of members from `first` up to `last`. */
+    static std::ptrdiff_t
+    distance(const_iterator first, const_iterator last);
+
+    friend bool
+    operator==(ObjectValues const& x, ObjectValues const& y);
+
+    friend bool
+    operator<(ObjectValues const& x, ObjectValues const& y);
+
+private:
+    static constexpr std::size_t inlineSlots = 4;
+    static constexpr std::size_t flatLimit = 32;
+    static constexpr std::size_t maxChunkSlots = 1024;
+
+    static iterator
+    toMutable(const_iterator it)
+    {
+        iterator result;
+        result.p_ = it.p_;
+        result.t_ = it.t_;
+        result.inTree_ = it.inTree_;
+        return result;
+    }
+
+    void*
+    allocate();
+
+    using Index = boost::container::small_vector<value_type*, inlineSlots>;
+
+    // At most one of these holds the members: index_ while the object is
+    // small, tree_ once it has outgrown flatLimit.
+    Index index_;
+    Tree tree_;
+    std::vector<void*> free_;
+    std::vector<std::pair<value_type*, std::size_t>> chunks_;
+    std::size_t used_ = 0;
+    alignas(value_type) unsigned char inline_[inlineSlots * sizeof(value_type)];
+};
+
 bool
 operator==(const Value&, const Value&);
 
@@ -25,8 +25,12 @@
 #include <ripple/json/json_value.h>
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/MultiApiJson.h>
 #include <ripple/resource/Consumer.h>
+#include <array>
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace ripple {
 
@@ -46,6 +50,41 @@ public:
     doStatus(Json::Value const&) = 0;
 };
 
+/** A JSON message published to many subscribers.
+
+    Subscribers which deliver the message as text share one serialization
+    per API version, produced the first time a subscriber asks for it.
+    The JSON is referenced, not copied, so it must outlive the message.
+    A message is used only by the thread which publishes it.
+*/
+class PublishedJson
+{
+public:
+    explicit PublishedJson(Json::Value const& jv);
+    explicit PublishedJson(MultiApiJson const& jv);
+
+    PublishedJson(PublishedJson const&) = delete;
+    PublishedJson&
+    operator=(PublishedJson const&) = delete;
+
+    /** The JSON for the given API version. */
+    Json::Value const&
+    json(unsigned int apiVersion) const;
+
+    /** The serialized JSON for the given API version. */
+    std::shared_ptr<std::string const> const&
+    text(unsigned int apiVersion) const;
+
+private:
+    std::size_t
+    index(unsigned int apiVersion) const;
+
+    Json::Value const* jv_ = nullptr;
+    MultiApiJson const* multiJv_ = nullptr;
+    mutable std::array<std::shared_ptr<std::string const>, MultiApiJson::size>
+        text_;
+};
+
 /** Manages a client's subscription to data feeds.
  */
 class InfoSub : public CountedObject<InfoSub>
@@ -201,6 +240,13 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message which is published to many subscribers.
+
+        The default sends the JSON for this subscriber's API version.
+    */
+    virtual void
+    publish(PublishedJson const& message);
+
     std::uint64_t
     getSeq();
 
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/json/json_writer.h>
 #include <ripple/net/InfoSub.h>
 #include <atomic>
 
@@ -77,6 +78,12 @@ InfoSub::getSeq()
     return mSeq;
 }
 
+void
+InfoSub::publish(PublishedJson const& message)
+{
+    send(message.json(getApiVersion()), true);
+}
+
 void
 InfoSub::onSendEmpty()
 {
@@ -149,4 +156,46 @@ InfoSub::getApiVersion() const noexcept
     return apiVersion_;
 }
 
+//------------------------------------------------------------------------------
+
+PublishedJson::PublishedJson(Json::Value const& jv) : jv_(&jv)
+{
+}
+
+PublishedJson::PublishedJson(MultiApiJson const& jv) : multiJv_(&jv)
+{
+}
+
+std::size_t
+PublishedJson::index(unsigned int apiVersion) const
+{
+    if (jv_)
+        return 0;
+    assert(MultiApiJson::valid(apiVersion));
+    return MultiApiJson::index(apiVersion);
+}
+
+Json::Value const&
+PublishedJson::json(unsigned int apiVersion) const
+{
+    if (jv_)
+        return *jv_;
+    return multiJv_->val[index(apiVersion)];
+}
+
+std::shared_ptr<std::string const> const&
+PublishedJson::text(unsigned int apiVersion) const
+{
+    auto& text = text_[index(apiVersion)];
+    if (!text)
+    {
+        auto s = std::make_shared<std::string>();
+        Json::stream(json(apiVersion), [&s](void const* data, std::size_t n) {
+            s->append(static_cast<char const*>(data), n);
+        });
+        text = std::move(s);
+    }
+    return text;
+}
+
 }  // namespace ripple
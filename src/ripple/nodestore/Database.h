@@ -353,6 +353,36 @@ protected:
         fetchDurationUs_ += duration;
     }
 
+    /** Record the statistics of a batch of asynchronous fetches.
+
+        Each object gets a scheduler report, as a single fetch would. The
+        batch's elapsed time is split between the reports, the first one
+        also taking what does not divide evenly, so that their sum is the
+        time the batch took.
+
+        @param objects The fetched objects, null for those not found.
+        @param elapsed How long the whole batch took.
+    */
+    void
+    reportFetchBatch(
+        std::vector<std::shared_ptr<NodeObject>> const& objects,
+        std::chrono::steady_clock::duration elapsed);
+
+    /** Fetch the objects of a bundle of asynchronous read requests.
+
+        Databases whose backend can look up several keys in one operation
+        should override this. The default fetches the objects one at a time.
+
+        @param hashes The hashes of the objects to fetch.
+        @param ledgerSeqs The ledger sequence of each request.
+        @return The objects, in the order of the hashes. An object which
+                was not found is null.
+    */
+    virtual std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::vector<std::uint32_t> const& ledgerSeqs);
+
 private:
     std::atomic<std::uint64_t> storeCount_{0};
     std::atomic<std::uint64_t> storeSz_{0};
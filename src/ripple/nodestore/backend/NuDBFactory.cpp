@@ -203,14 +203,24 @@ public:
 
     Status
     fetch(void const* key, std::shared_ptr<NodeObject>* pno) override
+    {
+        nudb::detail::buffer bf;
+        return fetch(key, pno, bf);
+    }
+
+    // The buffer is used for decompression, and can be reused between calls
+    Status
+    fetch(
+        void const* key,
+        std::shared_ptr<NodeObject>* pno,
+        nudb::detail::buffer& bf)
     {
         Status status;
         pno->reset();
         nudb::error_code ec;
         db_.fetch(
             key,
-            [key, pno, &status](void const* data, std::size_t size) {
-                nudb::detail::buffer bf;
+            [key, pno, &bf, &status](void const* data, std::size_t size) {
                 auto const result = nodeobject_decompress(data, size, bf);
                 DecodedBlob decoded(key, result.first, result.second);
                 if (!decoded.wasOk())
@@ -234,10 +244,11 @@ public:
     {
         std::vector<std::shared_ptr<NodeObject>> results;
         results.reserve(hashes.size());
+        nudb::detail::buffer bf;
         for (auto const& h : hashes)
         {
             std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
+            Status status = fetch(h->begin(), &nObj, bf);
             if (status != ok)
                 results.push_back({});
             else
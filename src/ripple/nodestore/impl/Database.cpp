@@ -67,6 +67,8 @@ Database::Database(
                     "db prefetch #" + std::to_string(i));
 
                 decltype(read_) read;
+                std::vector<uint256> hashes;
+                std::vector<std::uint32_t> ledgerSeqs;
 
                 while (true)
                 {
@@ -94,16 +96,25 @@ Database::Database(
                             read.insert(read_.extract(read_.begin()));
                     }
 
-                    for (auto it = read.begin(); it != read.end(); ++it)
+                    // Fetch the whole bundle at once, so that the backend
+                    // can batch the lookups.
+                    for (auto const& [hash, data] : read)
                     {
-                        assert(!it->second.empty());
+                        assert(!data.empty());
+                        hashes.push_back(hash);
+                        ledgerSeqs.push_back(data[0].first);
+                    }
+
+                    auto const objs = fetchNodeObjects(hashes, ledgerSeqs);
+                    assert(objs.size() == hashes.size());
 
+                    std::size_t i = 0;
+                    for (auto it = read.begin(); it != read.end(); ++it, ++i)
+                    {
                         auto const& hash = it->first;
                         auto const& data = it->second;
                         auto const seqn = data[0].first;
-
-                        auto obj =
-                            fetchNodeObject(hash, seqn, FetchType::async);
+                        auto const& obj = objs[i];
 
                         // This could be further optimized: if there are
                         // multiple requests for sequence numbers mapping to
@@ -121,6 +132,8 @@ Database::Database(
                     }
 
                     read.clear();
+                    hashes.clear();
+                    ledgerSeqs.clear();
                 }
 
                 --runningThreads_;
@@ -275,6 +288,57 @@ Database::fetchNodeObject(
     return nodeObject;
 }
 
+void
+Database::reportFetchBatch(
+    std::vector<std::shared_ptr<NodeObject>> const& objects,
+    std::chrono::steady_clock::duration elapsed)
+{
+    if (objects.empty())
+        return;
+
+    using namespace std::chrono;
+
+    std::uint64_t found = 0;
+    for (auto const& nodeObject : objects)
+    {
+        if (nodeObject)
+        {
+            ++found;
+            fetchSz_ += nodeObject->getData().size();
+        }
+    }
+    updateFetchMetrics(
+        objects.size(), found, duration_cast<microseconds>(elapsed).count());
+
+    auto const total = duration_cast<milliseconds>(elapsed);
+    auto const share = total / objects.size();
+    auto remainder = total - share * objects.size();
+
+    for (auto const& nodeObject : objects)
+    {
+        FetchReport fetchReport(FetchType::async);
+        fetchReport.elapsed = share + remainder;
+        fetchReport.wasFound = static_cast<bool>(nodeObject);
+        scheduler_.onFetch(fetchReport);
+        remainder = milliseconds{0};
+    }
+}
+
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::vector<std::uint32_t> const& ledgerSeqs)
+{
+    assert(hashes.size() == ledgerSeqs.size());
+
+    std::vector<std::shared_ptr<NodeObject>> results;
+    results.reserve(hashes.size());
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+        results.push_back(
+            fetchNodeObject(hashes[i], ledgerSeqs[i], FetchType::async));
+    return results;
+}
+
 bool
 Database::storeLedger(
     Ledger const& srcLedger,
@@ -143,22 +143,55 @@ DatabaseNodeImp::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::vector<std::uint32_t> const& ledgerSeqs)
+{
+    if (hashes.size() < 2)
+        return Database::fetchNodeObjects(hashes, ledgerSeqs);
+
+    using namespace std::chrono;
+    auto const before = steady_clock::now();
+
+    // Like fetchNodeObject, do not cache misses: a backend batch does not
+    // tell a missing key apart from one it failed to read.
+    std::uint64_t cacheHits = 0;
+    auto results = fetchBatch(hashes, false, cacheHits);
+
+    reportFetchBatch(results, steady_clock::now() - before);
+    return results;
+}
+
 std::vector<std::shared_ptr<NodeObject>>
 DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
 {
-    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
     using namespace std::chrono;
     auto const before = steady_clock::now();
+
+    std::uint64_t cacheHits = 0;
+    auto results = fetchBatch(hashes, true, cacheHits);
+
+    auto fetchDurationUs =
+        duration_cast<microseconds>(steady_clock::now() - before).count();
+    updateFetchMetrics(hashes.size(), cacheHits, fetchDurationUs);
+    return results;
+}
+
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchBatch(
+    std::vector<uint256> const& hashes,
+    bool cacheNotFound,
+    std::uint64_t& cacheHits)
+{
+    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
     std::unordered_map<uint256 const*, size_t> indexMap;
     std::vector<uint256 const*> cacheMisses;
-    uint64_t hits = 0;
-    uint64_t fetches = 0;
     for (size_t i = 0; i < hashes.size(); ++i)
     {
         auto const& hash = hashes[i];
         // See if the object already exists in the cache
         auto nObj = cache_ ? cache_->fetch(hash) : nullptr;
-        ++fetches;
         if (!nObj)
         {
             // Try the database
@@ -169,14 +202,44 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
         {
             results[i] = nObj->getType() == hotDUMMY ? nullptr : nObj;
             // It was in the cache.
-            ++hits;
+            ++cacheHits;
         }
     }
 
     JLOG(j_.debug()) << "fetchBatch - cache hits = "
                      << (hashes.size() - cacheMisses.size())
                      << " - cache misses = " << cacheMisses.size();
-    auto dbResults = backend_->fetchBatch(cacheMisses).first;
+
+    if (cacheMisses.empty())
+        return results;
+
+    std::vector<std::shared_ptr<NodeObject>> dbResults;
+    Status status;
+
+    try
+    {
+        std::tie(dbResults, status) = backend_->fetchBatch(cacheMisses);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) << "fetchBatch: Exception fetching from backend: "
+                         << e.what();
+        Rethrow();
+    }
+
+    switch (status)
+    {
+        case ok:
+        case notFound:
+            break;
+        case dataCorrupt:
+            JLOG(j_.fatal()) << "fetchBatch: nodestore data is corrupted";
+            break;
+        default:
+            JLOG(j_.warn())
+                << "fetchBatch: backend returns unknown result " << status;
+            break;
+    }
 
     for (size_t i = 0; i < dbResults.size(); ++i)
     {
@@ -192,10 +255,10 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
         }
         else
         {
-            JLOG(j_.error())
+            JLOG(j_.debug())
                 << "fetchBatch - "
                 << "record not found in db or cache. hash = " << strHex(hash);
-            if (cache_)
+            if (cache_ && cacheNotFound)
             {
                 auto notFound = NodeObject::createObject(hotDUMMY, {}, hash);
                 cache_->canonicalize_replace_client(hash, notFound);
@@ -206,11 +269,6 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
         results[index] = std::move(nObj);
     }
 
-    auto fetchDurationUs =
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            steady_clock::now() - before)
-            .count();
-    updateFetchMetrics(fetches, hits, fetchDurationUs);
     return results;
 }
 
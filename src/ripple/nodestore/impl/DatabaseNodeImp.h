@@ -151,6 +151,19 @@ private:
         FetchReport& fetchReport,
         bool duplicate) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256> const& hashes,
+        std::vector<std::uint32_t> const& ledgerSeqs) override;
+
+    // Look up hashes in the cache, then fetch the rest with one backend
+    // batch. Misses are cached as hotDUMMY only if cacheNotFound is set.
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch(
+        std::vector<uint256> const& hashes,
+        bool cacheNotFound,
+        std::uint64_t& cacheHits);
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
     {
@@ -191,6 +191,97 @@ DatabaseRotatingImp::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseRotatingImp::fetchNodeObjects(
+    std::vector<uint256> const& hashes,
+    std::vector<std::uint32_t> const&)
+{
+    using namespace std::chrono;
+    auto const before = steady_clock::now();
+
+    auto fetch = [&](std::shared_ptr<Backend> const& backend,
+                     std::vector<uint256 const*> const& keys) {
+        std::vector<std::shared_ptr<NodeObject>> nodeObjects;
+        Status status;
+        try
+        {
+            std::tie(nodeObjects, status) = backend->fetchBatch(keys);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "Exception, " << e.what();
+            Rethrow();
+        }
+
+        switch (status)
+        {
+            case ok:
+            case notFound:
+                break;
+            case dataCorrupt:
+                JLOG(j_.fatal()) << "Corrupt NodeObject in batch";
+                break;
+            default:
+                JLOG(j_.warn()) << "Unknown status=" << status;
+                break;
+        }
+
+        return nodeObjects;
+    };
+
+    auto const [writable, archive] = [&] {
+        std::lock_guard lock(mutex_);
+        return std::make_pair(writableBackend_, archiveBackend_);
+    }();
+
+    std::vector<uint256 const*> keys;
+    keys.reserve(hashes.size());
+    for (auto const& hash : hashes)
+        keys.push_back(&hash);
+
+    // Try to fetch everything from the writable backend
+    auto results = fetch(writable, keys);
+    results.resize(hashes.size());
+
+    // Look for the rest in the archive backend
+    std::vector<std::size_t> missing;
+    keys.clear();
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i])
+        {
+            missing.push_back(i);
+            keys.push_back(&hashes[i]);
+        }
+    }
+
+    if (!missing.empty())
+    {
+        auto archived = fetch(archive, keys);
+
+        Batch batch;
+        for (std::size_t i = 0; i < missing.size() && i < archived.size(); ++i)
+        {
+            if (archived[i])
+                batch.push_back(archived[i]);
+            results[missing[i]] = std::move(archived[i]);
+        }
+
+        if (!batch.empty())
+        {
+            // Update writable backend with data from the archive backend
+            auto const backend = [&] {
+                std::lock_guard lock(mutex_);
+                return writableBackend_;
+            }();
+            backend->storeBatch(batch);
+        }
+    }
+
+    reportFetchBatch(results, steady_clock::now() - before);
+    return results;
+}
+
 void
 DatabaseRotatingImp::for_each(
     std::function<void(std::shared_ptr<NodeObject>)> f)
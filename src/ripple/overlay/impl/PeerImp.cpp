@@ -270,18 +270,36 @@ PeerImp::send(std::shared_ptr<Message> const& m)
     {
         std::string const n = name();
         sink << (n.empty() ? remote_address_.to_string() : n)
-             << " sendq: " << sendq_size;
+             << " sendq: " << sendq_size << " consensus: "
+             << send_queue_.depth(SendQueue::Lane::consensus)
+             << " transaction: "
+             << send_queue_.depth(SendQueue::Lane::transaction)
+             << " bulk: " << send_queue_.depth(SendQueue::Lane::bulk);
     }
 
     send_queue_.push(m);
 
-    if (sendq_size != 0)
+    // If a write is in progress, the message goes out with a later one
+    if (send_queue_.writing())
         return;
 
+    writeQueued();
+}
+
+void
+PeerImp::writeQueued()
+{
+    assert(strand_.running_in_this_thread());
+    assert(!send_queue_.empty() && !send_queue_.writing());
+
+    // Gather the messages into one write, so that they share system calls
+    // and, since the SSL stream coalesces small buffers, TLS records. The
+    // send queue picks them by priority.
+    auto buffers = send_queue_.next(compressionEnabled_);
+
     boost::asio::async_write(
         stream_,
-        boost::asio::buffer(
-            send_queue_.front()->getBuffer(compressionEnabled_)),
+        std::move(buffers),
         bind_executor(
             strand_,
             std::bind(
@@ -490,6 +508,22 @@ PeerImp::json()
         std::to_string(metrics_.recv.average_bytes());
     ret[jss::metrics][jss::avg_bps_sent] =
         std::to_string(metrics_.sent.average_bytes());
+    ret[jss::metrics][jss::total_writes] = std::to_string(totalWrites_);
+    ret[jss::metrics][jss::total_messages_sent] =
+        std::to_string(totalMessagesWritten_);
+
+    {
+        auto& depth = ret[jss::metrics][jss::send_queue];
+        auto& peak = ret[jss::metrics][jss::send_queue_peak];
+        for (auto const& [lane, key] :
+             {std::pair{SendQueue::Lane::consensus, jss::consensus},
+              std::pair{SendQueue::Lane::transaction, jss::transaction},
+              std::pair{SendQueue::Lane::bulk, jss::bulk}})
+        {
+            depth[key] = std::to_string(send_queue_.depth(lane));
+            peak[key] = std::to_string(send_queue_.peak(lane));
+        }
+    }
 
     return ret;
 }
@@ -963,23 +997,14 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
     }
 
     metrics_.sent.add_message(bytes_transferred);
+    ++totalWrites_;
 
-    assert(!send_queue_.empty());
-    send_queue_.pop();
+    assert(send_queue_.writing());
+    totalMessagesWritten_ += send_queue_.written();
     if (!send_queue_.empty())
     {
         // Timeout on writes only
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(
-                send_queue_.front()->getBuffer(compressionEnabled_)),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
+        return writeQueued();
     }
 
     if (gracefulClose_)
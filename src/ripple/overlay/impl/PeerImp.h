@@ -31,6 +31,7 @@
 #include <ripple/overlay/impl/OverlayImpl.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/ProtocolVersion.h>
+#include <ripple/overlay/impl/SendQueue.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STTx.h>
@@ -40,9 +41,9 @@
 #include <boost/circular_buffer.hpp>
 #include <boost/endian/conversion.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <atomic>
 #include <cstdint>
 #include <optional>
-#include <queue>
 
 namespace ripple {
 
@@ -155,7 +156,10 @@ private:
     http_request_type request_;
     http_response_type response_;
     boost::beast::http::fields const& headers_;
-    std::queue<std::shared_ptr<Message>> send_queue_;
+    SendQueue send_queue_;
+    // How many writes and how many messages those carried, for json()
+    std::atomic<std::uint64_t> totalWrites_{0};
+    std::atomic<std::uint64_t> totalMessagesWritten_{0};
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     std::unique_ptr<LoadEvent> load_event_;
@@ -479,6 +483,10 @@ private:
     void
     onReadMessage(error_code ec, std::size_t bytes_transferred);
 
+    // Write the next queued messages, by priority, up to Tuning::maxWriteBytes
+    void
+    writeQueued();
+
     // Called when protocol messages bytes are sent
     void
     onWriteMessage(error_code ec, std::size_t bytes_transferred);
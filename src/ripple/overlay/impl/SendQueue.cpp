@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/safe_cast.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/Tuning.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ripple {
+
+SendQueue::Lane
+SendQueue::lane(TrafficCount::category category)
+{
+    using category_t = TrafficCount::category;
+
+    switch (category)
+    {
+        case category_t::transaction:
+        case category_t::get_transactions:
+        case category_t::have_transactions:
+        case category_t::requested_transactions:
+        // Transaction set candidates are needed during consensus, but they
+        // can be large.
+        case category_t::ld_tsc_get:
+        case category_t::ld_tsc_share:
+        case category_t::gl_tsc_get:
+        case category_t::gl_tsc_share:
+            return Lane::transaction;
+
+        case category_t::shards:
+        case category_t::ld_txn_get:
+        case category_t::ld_txn_share:
+        case category_t::ld_asn_get:
+        case category_t::ld_asn_share:
+        case category_t::ld_get:
+        case category_t::ld_share:
+        case category_t::gl_txn_share:
+        case category_t::gl_txn_get:
+        case category_t::gl_asn_share:
+        case category_t::gl_asn_get:
+        case category_t::gl_share:
+        case category_t::gl_get:
+        case category_t::share_hash_ledger:
+        case category_t::get_hash_ledger:
+        case category_t::share_hash_tx:
+        case category_t::get_hash_tx:
+        case category_t::share_hash_txnode:
+        case category_t::get_hash_txnode:
+        case category_t::share_hash_asnode:
+        case category_t::get_hash_asnode:
+        case category_t::share_cas_object:
+        case category_t::get_cas_object:
+        case category_t::share_fetch_pack:
+        case category_t::get_fetch_pack:
+        case category_t::share_hash:
+        case category_t::get_hash:
+        case category_t::proof_path_request:
+        case category_t::proof_path_response:
+        case category_t::replay_delta_request:
+        case category_t::replay_delta_response:
+            return Lane::bulk;
+
+        default:
+            return Lane::consensus;
+    }
+}
+
+void
+SendQueue::push(std::shared_ptr<Message> const& m)
+{
+    auto const l = static_cast<std::size_t>(
+        lane(safe_cast<TrafficCount::category>(m->getCategory())));
+    auto& queue = lanes_[l];
+    queue.push_back(m);
+    total_.fetch_add(1, std::memory_order_relaxed);
+
+    depth_[l].store(queue.size(), std::memory_order_relaxed);
+    if (queue.size() > peak_[l].load(std::memory_order_relaxed))
+        peak_[l].store(queue.size(), std::memory_order_relaxed);
+}
+
+void
+SendQueue::take(
+    std::size_t lane,
+    compression::Compressed compressed,
+    std::vector<boost::asio::const_buffer>& buffers)
+{
+    auto& queue = lanes_[lane];
+    auto const& buffer = queue.front()->getBuffer(compressed);
+    buffers.emplace_back(buffer.data(), buffer.size());
+    writing_.push_back(std::move(queue.front()));
+    queue.pop_front();
+    depth_[lane].store(queue.size(), std::memory_order_relaxed);
+}
+
+std::vector<boost::asio::const_buffer>
+SendQueue::next(compression::Compressed compressed)
+{
+    assert(writing_.empty());
+
+    std::vector<boost::asio::const_buffer> buffers;
+    std::size_t bytes = 0;
+
+    // Whether a message of this size still fits in the write. The first
+    // message always does, however large.
+    auto const fits = [&](std::size_t size) {
+        return buffers.empty() || bytes + size <= Tuning::maxWriteBytes;
+    };
+
+    auto& consensus = lanes_[static_cast<std::size_t>(Lane::consensus)];
+    while (!consensus.empty())
+    {
+        auto const size = consensus.front()->getBuffer(compressed).size();
+        if (!fits(size))
+            return buffers;
+        take(static_cast<std::size_t>(Lane::consensus), compressed, buffers);
+        bytes += size;
+    }
+
+    auto& transaction = lanes_[static_cast<std::size_t>(Lane::transaction)];
+    auto& bulk = lanes_[static_cast<std::size_t>(Lane::bulk)];
+    while (!transaction.empty() || !bulk.empty())
+    {
+        auto const l = static_cast<std::size_t>(turn_);
+        auto const& queue = lanes_[l];
+
+        if (!queue.empty())
+        {
+            if (!credited_)
+            {
+                deficit_[l] += turn_ == Lane::transaction
+                    ? Tuning::sendQuantumTransaction
+                    : Tuning::sendQuantumBulk;
+                credited_ = true;
+            }
+
+            auto const size = queue.front()->getBuffer(compressed).size();
+            if (size <= deficit_[l])
+            {
+                // The lane keeps its turn, and its credit, for the next
+                // write if this one is full.
+                if (!fits(size))
+                    break;
+                take(l, compressed, buffers);
+                bytes += size;
+                deficit_[l] -= size;
+                continue;
+            }
+        }
+        else
+        {
+            // An idle lane does not save up credit.
+            deficit_[l] = 0;
+        }
+
+        turn_ = turn_ == Lane::transaction ? Lane::bulk : Lane::transaction;
+        credited_ = false;
+    }
+
+    return buffers;
+}
+
+std::size_t
+SendQueue::written()
+{
+    auto const n = writing_.size();
+    writing_.clear();
+    total_.fetch_sub(n, std::memory_order_relaxed);
+    return n;
+}
+
+bool
+SendQueue::empty() const
+{
+    return std::all_of(lanes_.begin(), lanes_.end(), [](auto const& queue) {
+        return queue.empty();
+    });
+}
+
+}  // namespace ripple
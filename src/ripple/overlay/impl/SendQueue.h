@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#define RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+
+#include <ripple/overlay/Compression.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+
+#include <boost/asio/buffer.hpp>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+/** The messages waiting to be written to one peer.
+
+    Messages wait in lanes by urgency, so that consensus traffic is not
+    stuck behind megabytes of ledger data being served to the same peer:
+
+    - consensus: proposals, validations, validator lists, transaction set
+      adverts, status changes, pings and the other small overlay messages.
+      This lane is always served first. Its traffic is small and paced by
+      the consensus rounds, so it cannot starve the other lanes.
+    - transaction: relayed transactions and transaction set candidates.
+    - bulk: ledger data, fetch packs and the other object, proof path and
+      replay requests and replies.
+
+    The transaction and bulk lanes share the rest of each write by deficit
+    round robin, weighted by their quanta in Tuning. Each lane keeps its
+    messages in order.
+
+    Everything except size(), depth() and peak() must be called on the
+    peer's strand. Those three may be called from any thread.
+*/
+class SendQueue
+{
+public:
+    enum class Lane : std::size_t { consensus, transaction, bulk };
+
+    static constexpr std::size_t lanes = 3;
+
+    /** Return the lane for messages in a traffic category. */
+    static Lane
+    lane(TrafficCount::category category);
+
+    /** Add a message to the end of its lane. */
+    void
+    push(std::shared_ptr<Message> const& m);
+
+    /** Take the next messages to write out of their lanes.
+
+        Gathers up to Tuning::maxWriteBytes, or a single larger message. The
+        messages are kept alive, so their buffers stay valid, until written()
+        is called.
+
+        @param compressed Whether the peer accepts compressed messages.
+        @return The buffers to write, which are empty if nothing is waiting.
+    */
+    std::vector<boost::asio::const_buffer>
+    next(compression::Compressed compressed);
+
+    /** Release the messages taken by next(), which have been written.
+
+        @return How many messages were written.
+    */
+    std::size_t
+    written();
+
+    /** Return true if the messages taken by next() are being written. */
+    bool
+    writing() const
+    {
+        return !writing_.empty();
+    }
+
+    /** Return true if no message is waiting in any lane. */
+    bool
+    empty() const;
+
+    /** Return how many messages are waiting or being written. */
+    std::size_t
+    size() const
+    {
+        return total_.load(std::memory_order_relaxed);
+    }
+
+    /** Return how many messages are waiting in a lane. */
+    std::size_t
+    depth(Lane lane) const
+    {
+        return depth_[static_cast<std::size_t>(lane)].load(
+            std::memory_order_relaxed);
+    }
+
+    /** Return the most messages that have waited in a lane at once. */
+    std::size_t
+    peak(Lane lane) const
+    {
+        return peak_[static_cast<std::size_t>(lane)].load(
+            std::memory_order_relaxed);
+    }
+
+private:
+    void
+    take(
+        std::size_t lane,
+        compression::Compressed compressed,
+        std::vector<boost::asio::const_buffer>& buffers);
+
+    std::array<std::deque<std::shared_ptr<Message>>, lanes> lanes_;
+    std::vector<std::shared_ptr<Message>> writing_;
+
+    // Deficit round robin state for the transaction and bulk lanes: the
+    // bytes each may still write in its turn, whose turn it is, and whether
+    // that lane has been given its quantum for this turn yet.
+    std::array<std::size_t, lanes> deficit_{};
+    Lane turn_ = Lane::transaction;
+    bool credited_ = false;
+
+    std::atomic<std::size_t> total_{0};
+    std::array<std::atomic<std::size_t>, lanes> depth_{};
+    std::array<std::atomic<std::size_t>, lanes> peak_{};
+};
+
+}  // namespace ripple
+
+#endif
@@ -64,6 +64,16 @@ enum {
 /** Size of buffer used to read from the socket. */
 std::size_t constexpr readBufferBytes = 16384;
 
+/** How many bytes of queued messages to gather into one write. A larger
+    message is still written, on its own. */
+std::size_t constexpr maxWriteBytes = 65536;
+
+/** How many bytes the transaction and bulk send lanes may write in each of
+    their turns. When both are busy they share the connection in this ratio.
+*/
+std::size_t constexpr sendQuantumTransaction = 49152;
+std::size_t constexpr sendQuantumBulk = 16384;
+
 }  // namespace Tuning
 
 }  // namespace ripple
@@ -256,6 +256,21 @@ verify(
     Slice const& sig,
     bool mustBeFullyCanonical = true) noexcept;
 
+/** Usage statistics of the cache of parsed secp256k1 public keys.
+
+    Parsing a compressed secp256k1 public key requires decompressing it,
+    so verifyDigest keeps the most recently used keys in parsed form.
+*/
+struct PublicKeyCacheStats
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::size_t size = 0;
+};
+
+PublicKeyCacheStats
+getPublicKeyCacheStats();
+
 /** Calculate the 160-bit node ID from a node public key. */
 NodeID
 calcNodeID(PublicKey const&);
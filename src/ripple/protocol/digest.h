@@ -25,6 +25,7 @@
 #include <boost/endian/conversion.hpp>
 #include <algorithm>
 #include <array>
+#include <vector>
 
 namespace ripple {
 
@@ -237,6 +238,49 @@ sha512Half_s(Args const&... args)
     return static_cast<typename sha512_half_hasher_s::result_type>(h);
 }
 
+/** Computes the SHA512-Half of several messages of the same size.
+
+    The messages are hashed side by side in groups of eight when the
+    processor supports AVX2 or AVX-512, otherwise one at a time. The
+    implementation is selected at runtime.
+
+    @param messages Pointers to the first byte of each message.
+    @param size The size, in bytes, of every message.
+    @param digests Receives the digest of each message.
+    @param count The number of messages.
+*/
+void
+sha512HalfMulti(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests,
+    std::size_t count);
+
+namespace detail {
+
+using sha512_half_multi_fn = void (*)(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests,
+    std::size_t count);
+
+/** One implementation of sha512HalfMulti. */
+struct sha512_half_multi_kernel
+{
+    char const* name;
+    sha512_half_multi_fn fn;
+};
+
+/** Returns the sha512HalfMulti implementations this processor can run.
+
+    The OpenSSL fallback is always first. This lets tests check every
+    kernel against sha512Half, not only the one selected at runtime.
+*/
+std::vector<sha512_half_multi_kernel>
+sha512HalfMultiKernels();
+
+}  // namespace detail
+
 }  // namespace ripple
 
 #endif
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/strHex.h>
 #include <ripple/protocol/PublicKey.h>
@@ -24,6 +25,9 @@
 #include <ripple/protocol/impl/secp256k1.h>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <ed25519.h>
+#include <array>
+#include <atomic>
+#include <mutex>
 
 namespace ripple {
 
@@ -218,6 +222,131 @@ publicKeyType(Slice const& slice)
     return std::nullopt;
 }
 
+namespace {
+
+/** A bounded cache of parsed secp256k1 public keys.
+
+    A small number of accounts and validators sign most of the traffic, so
+    parsing (and decompressing) their keys once saves work on every
+    signature they produce.
+
+    The cache is split into shards, each with its own lock. Every shard
+    keeps two generations of keys: when the current generation is full it
+    becomes the previous one, and the old previous generation is dropped.
+    Keys found in the previous generation are moved to the current one, so
+    keys in regular use are never dropped.
+*/
+class Secp256k1KeyCache
+{
+    static constexpr std::size_t shardCount = 16;
+    static constexpr std::size_t generationSize = 512;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        hardened_hash_map<PublicKey, secp256k1_pubkey> current;
+        hardened_hash_map<PublicKey, secp256k1_pubkey> previous;
+    };
+
+    std::array<Shard, shardCount> shards_;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+
+    Shard&
+    shard(PublicKey const& publicKey)
+    {
+        // The first byte only tells whether y is odd
+        return shards_[publicKey.data()[1] % shardCount];
+    }
+
+public:
+    /** Returns the parsed form of a key, or false if it is invalid. */
+    bool
+    parse(PublicKey const& publicKey, secp256k1_pubkey& result)
+    {
+        auto& s = shard(publicKey);
+
+        {
+            std::lock_guard lock(s.mutex);
+
+            if (auto const it = s.current.find(publicKey);
+                it != s.current.end())
+            {
+                ++hits_;
+                result = it->second;
+                return true;
+            }
+
+            if (auto const it = s.previous.find(publicKey);
+                it != s.previous.end())
+            {
+                ++hits_;
+                result = it->second;
+                s.previous.erase(it);
+                insert(s, publicKey, result);
+                return true;
+            }
+        }
+
+        ++misses_;
+
+        if (secp256k1_ec_pubkey_parse(
+                secp256k1Context(),
+                &result,
+                reinterpret_cast<unsigned char const*>(publicKey.data()),
+                publicKey.size()) != 1)
+            return false;
+
+        std::lock_guard lock(s.mutex);
+        insert(s, publicKey, result);
+        return true;
+    }
+
+    PublicKeyCacheStats
+    stats()
+    {
+        PublicKeyCacheStats ret;
+        ret.hits = hits_;
+        ret.misses = misses_;
+
+        for (auto& s : shards_)
+        {
+            std::lock_guard lock(s.mutex);
+            ret.size += s.current.size() + s.previous.size();
+        }
+
+        return ret;
+    }
+
+private:
+    static void
+    insert(Shard& s, PublicKey const& publicKey, secp256k1_pubkey const& key)
+    {
+        if (s.current.size() >= generationSize)
+        {
+            s.previous = std::move(s.current);
+            s.current.clear();
+        }
+
+        s.current.emplace(publicKey, key);
+    }
+};
+
+Secp256k1KeyCache&
+secp256k1KeyCache()
+{
+    static Secp256k1KeyCache cache;
+    return cache;
+}
+
+}  // namespace
+
+PublicKeyCacheStats
+getPublicKeyCacheStats()
+{
+    return secp256k1KeyCache().stats();
+}
+
 bool
 verifyDigest(
     PublicKey const& publicKey,
@@ -235,11 +364,7 @@ verifyDigest(
         return false;
 
     secp256k1_pubkey pubkey_imp;
-    if (secp256k1_ec_pubkey_parse(
-            secp256k1Context(),
-            &pubkey_imp,
-            reinterpret_cast<unsigned char const*>(publicKey.data()),
-            publicKey.size()) != 1)
+    if (!secp256k1KeyCache().parse(publicKey, pubkey_imp))
         return false;
 
     secp256k1_ecdsa_signature sig_imp;
@@ -27,6 +27,8 @@
 #include <ripple/protocol/STCurrency.h>
 #include <ripple/protocol/STObject.h>
 
+#include <boost/container/small_vector.hpp>
+
 namespace ripple {
 
 STObject::STObject(STObject&& other)
@@ -144,12 +146,20 @@ STObject::applyTemplate(const SOTemplate& type)
     assert(mType->size() > 0);
     decltype(v_) v;
     v.reserve(type.size());
+
+    // Fields moved into the new data are flagged rather than erased, so the
+    // remaining fields don't need to be shifted down each time.
+    boost::container::small_vector<bool, 64> used(v_.size(), false);
+
     for (auto const& e : type)
     {
-        auto const iter =
-            std::find_if(v_.begin(), v_.end(), [&](detail::STVar const& b) {
-                return b.get().getFName() == e.sField();
-            });
+        auto iter = v_.begin();
+        for (; iter != v_.end(); ++iter)
+        {
+            if (!used[iter - v_.begin()] &&
+                iter->get().getFName() == e.sField())
+                break;
+        }
         if (iter != v_.end())
         {
             if ((e.style() == soeDEFAULT) && iter->get().isDefault())
@@ -159,7 +169,7 @@ STObject::applyTemplate(const SOTemplate& type)
                     "may not be explicitly set to default.");
             }
             v.emplace_back(std::move(*iter));
-            v_.erase(iter);
+            used[iter - v_.begin()] = true;
         }
         else
         {
@@ -170,13 +180,13 @@ STObject::applyTemplate(const SOTemplate& type)
             v.emplace_back(detail::nonPresentObject, e.sField());
         }
     }
-    for (auto const& e : v_)
+    for (std::size_t i = 0; i < v_.size(); ++i)
     {
         // Anything left over in the object must be discardable
-        if (!e->getFName().isDiscardable())
+        if (!used[i] && !v_[i]->getFName().isDiscardable())
         {
             throwFieldErr(
-                e->getFName().getName(), "found in disallowed location.");
+                v_[i]->getFName().getName(), "found in disallowed location.");
         }
     }
     // Swap the template matching data in for the old data,
@@ -18,10 +18,16 @@
 //==============================================================================
 
 #include <ripple/protocol/digest.h>
+#include <boost/endian/conversion.hpp>
 #include <openssl/ripemd.h>
 #include <openssl/sha.h>
+#include <cstring>
 #include <type_traits>
 
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define RIPPLE_SHA512_MULTI_LANE 1
+#endif
+
 namespace ripple {
 
 openssl_ripemd160_hasher::openssl_ripemd160_hasher()
@@ -103,4 +109,312 @@ openssl_sha256_hasher::operator result_type() noexcept
     return digest;
 }
 
+//------------------------------------------------------------------------------
+
+namespace {
+
+using detail::sha512_half_multi_fn;
+
+// Hashes each message on its own with OpenSSL.
+void
+sha512HalfScalar(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests,
+    std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uint8_t digest[SHA512_DIGEST_LENGTH];
+        SHA512(messages[i], size, digest);
+        digests[i] = uint256::fromVoid(digest);
+    }
+}
+
+#ifdef RIPPLE_SHA512_MULTI_LANE
+
+// The multi-lane kernel below is plain C++ in which every step of the
+// SHA-512 computation is a loop over independent lanes. Compiled for a
+// target with wide vector registers, each of those loops becomes a handful
+// of vector instructions.
+
+constexpr std::uint64_t sha512K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+constexpr std::uint64_t sha512IV[8] = {
+    0x6a09e667f3bcc908ULL,
+    0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL,
+    0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL,
+    0x5be0cd19137e2179ULL};
+
+[[gnu::always_inline]] inline std::uint64_t
+rotr(std::uint64_t x, int n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+// Copies the given 128-byte block of a message, applying the SHA-512
+// padding to the blocks past the end of the message.
+[[gnu::always_inline]] inline void
+sha512Block(
+    std::uint8_t const* message,
+    std::size_t size,
+    std::size_t block,
+    std::uint8_t (&out)[128])
+{
+    std::size_t const begin = block * 128;
+    std::size_t const copied =
+        begin < size ? std::min<std::size_t>(size - begin, 128) : 0;
+
+    std::memcpy(out, message + begin, copied);
+    std::memset(out + copied, 0, 128 - copied);
+
+    if (begin + copied == size && copied < 128)
+        out[copied] = 0x80;
+
+    if (begin + 128 == ((size + 17 + 127) / 128) * 128)
+    {
+        std::uint64_t const bits = boost::endian::native_to_big(
+            static_cast<std::uint64_t>(size) << 3);
+        std::uint64_t const high = boost::endian::native_to_big(
+            static_cast<std::uint64_t>(size) >> 61);
+        std::memcpy(out + 112, &high, 8);
+        std::memcpy(out + 120, &bits, 8);
+    }
+}
+
+// Computes the SHA512-Half of exactly Lanes messages side by side.
+template <std::size_t Lanes>
+[[gnu::always_inline]] inline void
+sha512HalfLanes(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests)
+{
+    std::uint64_t state[8][Lanes];
+    for (int i = 0; i < 8; ++i)
+        for (std::size_t l = 0; l < Lanes; ++l)
+            state[i][l] = sha512IV[i];
+
+    std::size_t const blocks = (size + 17 + 127) / 128;
+
+    for (std::size_t block = 0; block < blocks; ++block)
+    {
+        std::uint64_t w[80][Lanes];
+
+        for (std::size_t l = 0; l < Lanes; ++l)
+        {
+            std::uint8_t data[128];
+            sha512Block(messages[l], size, block, data);
+
+            for (int t = 0; t < 16; ++t)
+            {
+                std::uint64_t v;
+                std::memcpy(&v, data + 8 * t, 8);
+                w[t][l] = boost::endian::big_to_native(v);
+            }
+        }
+
+        for (int t = 16; t < 80; ++t)
+        {
+            for (std::size_t l = 0; l < Lanes; ++l)
+            {
+                auto const x = w[t - 15][l];
+                auto const y = w[t - 2][l];
+                auto const s0 = rotr(x, 1) ^ rotr(x, 8) ^ (x >> 7);
+                auto const s1 = rotr(y, 19) ^ rotr(y, 61) ^ (y >> 6);
+                w[t][l] = w[t - 16][l] + s0 + w[t - 7][l] + s1;
+            }
+        }
+
+        std::uint64_t a[Lanes], b[Lanes], c[Lanes], d[Lanes];
+        std::uint64_t e[Lanes], f[Lanes], g[Lanes], h[Lanes];
+
+        for (std::size_t l = 0; l < Lanes; ++l)
+        {
+            a[l] = state[0][l];
+            b[l] = state[1][l];
+            c[l] = state[2][l];
+            d[l] = state[3][l];
+            e[l] = state[4][l];
+            f[l] = state[5][l];
+            g[l] = state[6][l];
+            h[l] = state[7][l];
+        }
+
+        for (int t = 0; t < 80; ++t)
+        {
+            for (std::size_t l = 0; l < Lanes; ++l)
+            {
+                auto const S1 =
+                    rotr(e[l], 14) ^ rotr(e[l], 18) ^ rotr(e[l], 41);
+                auto const ch = (e[l] & f[l]) ^ (~e[l] & g[l]);
+                auto const t1 = h[l] + S1 + ch + sha512K[t] + w[t][l];
+                auto const S0 =
+                    rotr(a[l], 28) ^ rotr(a[l], 34) ^ rotr(a[l], 39);
+                auto const maj =
+                    (a[l] & b[l]) ^ (a[l] & c[l]) ^ (b[l] & c[l]);
+                auto const t2 = S0 + maj;
+
+                h[l] = g[l];
+                g[l] = f[l];
+                f[l] = e[l];
+                e[l] = d[l] + t1;
+                d[l] = c[l];
+                c[l] = b[l];
+                b[l] = a[l];
+                a[l] = t1 + t2;
+            }
+        }
+
+        for (std::size_t l = 0; l < Lanes; ++l)
+        {
+            state[0][l] += a[l];
+            state[1][l] += b[l];
+            state[2][l] += c[l];
+            state[3][l] += d[l];
+            state[4][l] += e[l];
+            state[5][l] += f[l];
+            state[6][l] += g[l];
+            state[7][l] += h[l];
+        }
+    }
+
+    // The half digest is the first four words of the state
+    for (std::size_t l = 0; l < Lanes; ++l)
+    {
+        std::uint64_t half[4];
+        for (int i = 0; i < 4; ++i)
+            half[i] = boost::endian::native_to_big(state[i][l]);
+        digests[l] = uint256::fromVoid(half);
+    }
+}
+
+template <std::size_t Lanes>
+[[gnu::always_inline]] inline void
+sha512HalfMultiLane(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests,
+    std::size_t count)
+{
+    std::size_t i = 0;
+
+    for (; i + Lanes <= count; i += Lanes)
+        sha512HalfLanes<Lanes>(messages + i, size, digests + i);
+
+    if (i == count)
+        return;
+
+    // Fill the unused lanes of the last group with a copy of its first
+    // message and throw their digests away.
+    std::uint8_t const* tail[Lanes];
+    uint256 tailDigests[Lanes];
+
+    for (std::size_t l = 0; l < Lanes; ++l)
+        tail[l] = messages[i + l < count ? i + l : i];
+
+    sha512HalfLanes<Lanes>(tail, size, tailDigests);
+
+    for (std::size_t l = 0; i + l < count; ++l)
+        digests[i + l] = tailDigests[l];
+}
+
+__attribute__((target("avx512f"))) void
+sha512HalfAvx512(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests,
+    std::size_t count)
+{
+    sha512HalfMultiLane<8>(messages, size, digests, count);
+}
+
+__attribute__((target("avx2"))) void
+sha512HalfAvx2(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests,
+    std::size_t count)
+{
+    sha512HalfMultiLane<8>(messages, size, digests, count);
+}
+
+#endif
+
+}  // namespace
+
+namespace detail {
+
+std::vector<sha512_half_multi_kernel>
+sha512HalfMultiKernels()
+{
+    // Keep these in order from slowest to fastest: sha512HalfMulti uses the
+    // last one.
+    std::vector<sha512_half_multi_kernel> kernels{
+        {"openssl", sha512HalfScalar}};
+
+#ifdef RIPPLE_SHA512_MULTI_LANE
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        kernels.push_back({"avx2", sha512HalfAvx2});
+
+    if (__builtin_cpu_supports("avx512f"))
+        kernels.push_back({"avx512f", sha512HalfAvx512});
+#endif
+
+    return kernels;
+}
+
+}  // namespace detail
+
+void
+sha512HalfMulti(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* digests,
+    std::size_t count)
+{
+    // Use the fastest kernel this processor supports.
+    static sha512_half_multi_fn const fn =
+        detail::sha512HalfMultiKernels().back().fn;
+
+    // A single message gains nothing from the multi-lane kernels.
+    if (count == 1)
+        return sha512HalfScalar(messages, size, digests, count);
+
+    fn(messages, size, digests, count);
+}
+
 }  // namespace ripple
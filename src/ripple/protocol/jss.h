@@ -234,6 +234,7 @@ JSS(bridge);                      // in: LedgerEntry
 JSS(bridge_account);              // in: LedgerEntry
 JSS(build_path);                  // in: TransactionSign
 JSS(build_version);               // out: NetworkOPs
+JSS(bulk);                        // out: Peers
 JSS(cancel_after);                // out: AccountChannels
 JSS(can_delete);                  // out: CanDelete
 JSS(changes);                     // out: BookChanges
@@ -570,6 +571,9 @@ JSS(propose_seq);                 // out: LedgerPropose
 JSS(proposers);                   // out: NetworkOPs, LedgerConsensus
 JSS(protocol);                    // out: NetworkOPs, PeerImp
 JSS(proxied);                     // out: RPC ping
+JSS(pubkey_cache_hits);           // out: GetCounts
+JSS(pubkey_cache_misses);         // out: GetCounts
+JSS(pubkey_cache_size);           // out: GetCounts
 JSS(pubkey_node);                 // out: NetworkOPs
 JSS(pubkey_publisher);            // out: ValidatorList
 JSS(pubkey_validator);            // out: NetworkOPs, ValidatorList
@@ -621,6 +625,8 @@ JSS(seed);                      //
 JSS(seed_hex);                  // in: WalletPropose, TransactionSign
 JSS(send_currencies);           // out: AccountCurrencies
 JSS(send_max);                  // in: PathRequest, RipplePathFind
+JSS(send_queue);                // out: Peers
+JSS(send_queue_peak);           // out: Peers
 JSS(seq);                       // in: LedgerEntry;
                                 // out: NetworkOPs, RPCSub, AccountOffers,
                                 //      ValidatorList, ValidatorInfo, Manifest
@@ -688,6 +694,8 @@ JSS(total);                   // out: counters
 JSS(total_bytes_recv);        // out: Peers
 JSS(total_bytes_sent);        // out: Peers
 JSS(total_coins);             // out: LedgerToJson
+JSS(total_messages_sent);     // out: Peers
+JSS(total_writes);            // out: Peers
 JSS(trading_fee);             // out: amm_info
 JSS(transTreeHash);           // out: ledger/Ledger.cpp
 JSS(transaction);             // in: Tx
@@ -29,6 +29,7 @@
 #include <ripple/nodestore/Database.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/RPCErr.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
@@ -119,6 +120,13 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::treenode_track_size] =
         app.getNodeFamily().getTreeNodeCache(0)->getTrackSize();
 
+    {
+        auto const pubKeyCache = getPublicKeyCacheStats();
+        ret[jss::pubkey_cache_size] = static_cast<int>(pubKeyCache.size);
+        ret[jss::pubkey_cache_hits] = std::to_string(pubKeyCache.hits);
+        ret[jss::pubkey_cache_misses] = std::to_string(pubKeyCache.misses);
+    }
+
     std::string uptime;
     auto s = UptimeClock::now();
     using namespace std::chrono_literals;
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/ErrorCodes.h>
@@ -30,6 +31,51 @@
 
 namespace ripple {
 
+// Call f with the key and serialized form of each state entry whose key
+// follows `key`, in key order, until f returns false. The state map of a
+// ledger already holds every entry serialized, so its leaves are passed
+// as they are rather than deserialized and serialized again.
+template <class F>
+static void
+forEachStateBlob(ReadView const& view, uint256 const& key, F&& f)
+{
+    if (auto const ledger = dynamic_cast<Ledger const*>(&view))
+    {
+        auto const& map = ledger->stateMap();
+        for (auto i = map.upper_bound(key), e = map.end(); i != e; ++i)
+        {
+            if (!f(i->key(), i->slice()))
+                return;
+        }
+        return;
+    }
+
+    Serializer s;
+    for (auto i = view.sles.upper_bound(key), e = view.sles.end(); i != e;
+         ++i)
+    {
+        s.erase();
+        (*i)->add(s);
+        if (!f((*i)->key(), s.slice()))
+            return;
+    }
+}
+
+// The type of a serialized ledger entry.
+static std::uint16_t
+entryType(uint256 const& key, Slice data)
+{
+    // Fields are serialized in canonical order, so the entry type, which
+    // every entry has, comes first.
+    SerialIter sit(data);
+    int type, name;
+    sit.getFieldID(type, name);
+    if (type == sfLedgerEntryType.fieldType &&
+        name == sfLedgerEntryType.fieldValue)
+        return sit.get16();
+    return STLedgerEntry(SerialIter(data), key).getType();
+}
+
 // Get state nodes from a ledger
 //   Inputs:
 //     limit:        integer, maximum number of entries
@@ -99,10 +145,33 @@ doLedgerData(RPC::JsonContext& context)
         nodes = Json::Value(Json::arrayValue);
     }
 
+    if (isBinary)
+    {
+        forEachStateBlob(
+            *lpLedger, key, [&](uint256 const& index, Slice data) {
+                if (limit-- <= 0)
+                {
+                    // Stop processing before the current key.
+                    auto k = index;
+                    jvResult[jss::marker] = to_string(--k);
+                    return false;
+                }
+
+                if (type == ltANY || entryType(index, data) == type)
+                {
+                    Json::Value& entry = nodes.append(Json::objectValue);
+                    entry[jss::data] = strHex(data);
+                    entry[jss::index] = to_string(index);
+                }
+                return true;
+            });
+        return jvResult;
+    }
+
     auto e = lpLedger->sles.end();
     for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
     {
-        auto sle = lpLedger->read(keylet::unchecked((*i)->key()));
+        auto const& sle = *i;
         if (limit-- <= 0)
         {
             // Stop processing before the current key.
@@ -113,18 +182,8 @@ doLedgerData(RPC::JsonContext& context)
 
         if (type == ltANY || sle->getType() == type)
         {
-            if (isBinary)
-            {
-                Json::Value& entry = nodes.append(Json::objectValue);
-                entry[jss::data] = serializeHex(*sle);
-                entry[jss::index] = to_string(sle->key());
-            }
-            else
-            {
-                Json::Value& entry =
-                    nodes.append(sle->getJson(JsonOptions::none));
-                entry[jss::index] = to_string(sle->key());
-            }
+            Json::Value& entry = nodes.append(sle->getJson(JsonOptions::none));
+            entry[jss::index] = to_string(sle->key());
         }
     }
 
@@ -168,10 +227,10 @@ doLedgerDataGrpc(
         return {response, errorStatus};
     }
 
-    auto e = ledger->sles.end();
+    std::optional<uint256> endKey;
     if (auto key = uint256::fromVoidChecked(request.end_marker()))
     {
-        e = ledger->sles.upper_bound(*key);
+        endKey = *key;
     }
     else if (request.end_marker().size() != 0)
     {
@@ -182,23 +241,22 @@ doLedgerDataGrpc(
 
     int maxLimit = RPC::Tuning::pageLength(true);
 
-    for (auto i = ledger->sles.upper_bound(startKey); i != e; ++i)
-    {
-        auto sle = ledger->read(keylet::unchecked((*i)->key()));
+    forEachStateBlob(*ledger, startKey, [&](uint256 const& key, Slice data) {
+        if (endKey && key > *endKey)
+            return false;
         if (maxLimit-- <= 0)
         {
             // Stop processing before the current key.
-            auto k = sle->key();
+            auto k = key;
             --k;
             response.set_marker(k.data(), k.size());
-            break;
+            return false;
         }
         auto stateObject = response.mutable_ledger_objects()->add_objects();
-        Serializer s;
-        sle->add(s);
-        stateObject->set_data(s.peekData().data(), s.getLength());
-        stateObject->set_key(sle->key().data(), sle->key().size());
-    }
+        stateObject->set_data(data.data(), data.size());
+        stateObject->set_key(key.data(), key.size());
+        return true;
+    });
     return {response, status};
 }
 
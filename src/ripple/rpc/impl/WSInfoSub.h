@@ -81,6 +81,16 @@ public:
         auto m = std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb));
         sp->send(m);
     }
+
+    void
+    publish(PublishedJson const& message) override
+    {
+        auto sp = ws_.lock();
+        if (!sp)
+            return;
+        sp->send(
+            std::make_shared<SharedWSMsg>(message.text(getApiVersion())));
+    }
 };
 
 }  // namespace ripple
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -104,6 +105,48 @@ public:
     }
 };
 
+/** A message whose bytes are shared with other sessions.
+
+    The text is immutable, so one serialization of a published message
+    can be queued on every session without copying it.
+*/
+class SharedWSMsg : public WSMsg
+{
+    std::shared_ptr<std::string const> text_;
+    std::size_t pos_ = 0;
+    std::size_t n_ = 0;
+
+public:
+    explicit SharedWSMsg(std::shared_ptr<std::string const> text)
+        : text_(std::move(text))
+    {
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)>) override
+    {
+        pos_ += n_;
+        auto const remaining = text_->size() - pos_;
+        if (remaining == 0)
+        {
+            n_ = 0;
+            return {true, {}};
+        }
+        boost::tribool done;
+        if (bytes < remaining)
+        {
+            n_ = bytes;
+            done = false;
+        }
+        else
+        {
+            n_ = remaining;
+            done = true;
+        }
+        return {done, {boost::asio::buffer(text_->data() + pos_, n_)}};
+    }
+};
+
 struct WSSession
 {
     std::shared_ptr<void> appDefined;
@@ -244,6 +244,20 @@ public:
     void
     visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const;
 
+    /**  Visit the nodes below one branch of the root, depth first
+
+         Different branches may be visited concurrently. The root node
+         itself is not visited.
+
+         @param branch The branch of the root node to visit.
+         @param function called with every node before its children. If it
+         returns false for an inner node, that node's children are skipped.
+    */
+    void
+    visitBranch(
+        int branch,
+        std::function<bool(SHAMapTreeNode&)> const& function) const;
+
     /**  Visit every node in this SHAMap that
          is not present in the specified SHAMap
 
@@ -340,13 +354,23 @@ public:
     bool
     compare(SHAMap const& otherMap, Delta& differences, int maxCount) const;
 
-    /** Convert any modified nodes to shared. */
+    /** Convert any modified nodes to shared.
+
+        @param parallel If true, the modified subtrees below the root are
+                        hashed concurrently, one thread per top-level branch.
+     */
     int
-    unshare();
+    unshare(bool parallel = false);
+
+    /** Flush modified nodes to the nodestore and convert them to shared.
 
-    /** Flush modified nodes to the nodestore and convert them to shared. */
+        @param parallel If true, the modified subtrees below the root are
+                        hashed and written concurrently, one thread per
+                        top-level branch. The resulting map is identical to
+                        the one produced by the serial walk.
+     */
     int
-    flushDirty(NodeObjectType t);
+    flushDirty(NodeObjectType t, bool parallel = false);
 
     void
     walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing) const;
@@ -503,7 +527,20 @@ private:
         Delta& differences,
         int& maxCount) const;
     int
-    walkSubTree(bool doWrite, NodeObjectType t);
+    walkSubTree(bool doWrite, NodeObjectType t, bool parallel);
+
+    /** Flush the modified nodes below an inner node, then the node itself.
+
+        The node must already have been prepared with preFlushNode.
+
+        @return the (possibly canonicalized) inner node to hook to its parent
+     */
+    std::shared_ptr<SHAMapInnerNode>
+    flushSubTree(
+        std::shared_ptr<SHAMapInnerNode> node,
+        bool doWrite,
+        NodeObjectType t,
+        int& flushed);
 
     // Structure to track information about call to
     // getMissingNodes while it's in progress
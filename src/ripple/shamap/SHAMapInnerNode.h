@@ -36,6 +36,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace ripple {
 
@@ -176,6 +177,14 @@ public:
     void
     updateHashDeep();
 
+    /** Recalculate the hash of all children and of each of the given nodes.
+
+        This has the same effect as calling updateHashDeep on every node,
+        but the nodes are hashed together using sha512HalfMulti.
+     */
+    static void
+    updateHashDeep(std::vector<std::shared_ptr<SHAMapInnerNode>> const& nodes);
+
     void
     serializeForWire(Serializer&) const override;
 
@@ -25,6 +25,10 @@
 #include <ripple/shamap/SHAMapTxLeafNode.h>
 #include <ripple/shamap/SHAMapTxPlusMetaLeafNode.h>
 
+#include <array>
+#include <exception>
+#include <thread>
+
 namespace ripple {
 
 [[nodiscard]] std::shared_ptr<SHAMapLeafNode>
@@ -982,21 +986,21 @@ SHAMap::preFlushNode(std::shared_ptr<Node> node) const
 }
 
 int
-SHAMap::unshare()
+SHAMap::unshare(bool parallel)
 {
     // Don't share nodes with parent map
-    return walkSubTree(false, hotUNKNOWN);
+    return walkSubTree(false, hotUNKNOWN, parallel);
 }
 
 int
-SHAMap::flushDirty(NodeObjectType t)
+SHAMap::flushDirty(NodeObjectType t, bool parallel)
 {
     // We only write back if this map is backed.
-    return walkSubTree(backed_, t);
+    return walkSubTree(backed_, t, parallel);
 }
 
 int
-SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
+SHAMap::walkSubTree(bool doWrite, NodeObjectType t, bool parallel)
 {
     assert(!doWrite || backed_);
 
@@ -1025,99 +1029,225 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         return 1;
     }
 
-    // Stack of {parent,index,child} pointers representing
-    // inner nodes we are in the process of flushing
-    using StackEntry = std::pair<std::shared_ptr<SHAMapInnerNode>, int>;
-    std::stack<StackEntry, std::vector<StackEntry>> stack;
-
     node = preFlushNode(std::move(node));
 
-    int pos = 0;
+    if (!parallel)
+    {
+        root_ = flushSubTree(std::move(node), doWrite, t, flushed);
+        return flushed;
+    }
+
+    // Flush the leaves hanging directly off the root and collect the
+    // modified inner subtrees, which are independent of each other.
+    std::array<std::shared_ptr<SHAMapInnerNode>, branchFactor> subTrees;
+    int pending = 0;
 
-    // We can't flush an inner node until we flush its children
-    while (1)
+    for (int branch = 0; branch < branchFactor; ++branch)
     {
-        while (pos < branchFactor)
+        if (node->isEmptyBranch(branch))
+            continue;
+
+        auto child = node->getChild(branch);
+
+        if (!child || (child->cowid() == 0))
+            continue;
+
+        child = preFlushNode(std::move(child));
+
+        if (child->isInner())
         {
-            if (node->isEmptyBranch(pos))
-            {
-                ++pos;
-            }
-            else
+            subTrees[branch] =
+                std::static_pointer_cast<SHAMapInnerNode>(std::move(child));
+            ++pending;
+        }
+        else
+        {
+            ++flushed;
+
+            child->updateHash();
+            child->unshare();
+
+            if (doWrite)
+                child = writeNode(t, std::move(child));
+
+            node->shareChild(branch, child);
+        }
+    }
+
+    std::array<int, branchFactor> counts{};
+    std::array<std::exception_ptr, branchFactor> errors;
+
+    auto flushBranch = [&](int branch) {
+        try
+        {
+            subTrees[branch] = flushSubTree(
+                std::move(subTrees[branch]), doWrite, t, counts[branch]);
+        }
+        catch (...)
+        {
+            errors[branch] = std::current_exception();
+        }
+    };
+
+    if (pending > 1)
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(pending);
+
+        for (int branch = 0; branch < branchFactor; ++branch)
+        {
+            if (subTrees[branch])
+                workers.emplace_back(flushBranch, branch);
+        }
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+    else
+    {
+        for (int branch = 0; branch < branchFactor; ++branch)
+        {
+            if (subTrees[branch])
+                flushBranch(branch);
+        }
+    }
+
+    // Join the subtrees back to the root in branch order, so the result
+    // does not depend on the order in which the workers finished.
+    for (int branch = 0; branch < branchFactor; ++branch)
+    {
+        if (errors[branch])
+            std::rethrow_exception(errors[branch]);
+
+        if (subTrees[branch])
+        {
+            node->shareChild(branch, subTrees[branch]);
+            flushed += counts[branch];
+        }
+    }
+
+    node->updateHashDeep();
+    node->unshare();
+
+    if (doWrite)
+        node = std::static_pointer_cast<SHAMapInnerNode>(
+            writeNode(t, std::move(node)));
+
+    ++flushed;
+
+    root_ = std::move(node);
+
+    return flushed;
+}
+
+std::shared_ptr<SHAMapInnerNode>
+SHAMap::flushSubTree(
+    std::shared_ptr<SHAMapInnerNode> node,
+    bool doWrite,
+    NodeObjectType t,
+    int& flushed)
+{
+    // A modified inner node, along with the parent it must be hooked
+    // back into once it has been flushed.
+    struct DirtyNode
+    {
+        std::shared_ptr<SHAMapInnerNode> node;
+        SHAMapInnerNode* parent;
+        int branch;
+    };
+
+    // We can't flush an inner node until we flush its children, but all
+    // the inner nodes at the same depth are independent of each other.
+    // So collect the modified inner nodes level by level, flushing leaves
+    // as they are found, and then hash each level in a single batch,
+    // deepest first.
+    std::vector<std::vector<DirtyNode>> levels;
+    levels.emplace_back().push_back({std::move(node), nullptr, 0});
+
+    for (std::size_t depth = 0; depth < levels.size(); ++depth)
+    {
+        for (std::size_t i = 0; i < levels[depth].size(); ++i)
+        {
+            auto parent = levels[depth][i].node;
+
+            for (int branch = 0; branch < branchFactor; ++branch)
             {
+                if (parent->isEmptyBranch(branch))
+                    continue;
+
                 // No need to do I/O. If the node isn't linked,
                 // it can't need to be flushed
-                int branch = pos;
-                auto child = node->getChild(pos++);
+                auto child = parent->getChild(branch);
 
-                if (child && (child->cowid() != 0))
-                {
-                    // This is a node that needs to be flushed
+                if (!child || (child->cowid() == 0))
+                    continue;
 
-                    child = preFlushNode(std::move(child));
+                // This is a node that needs to be flushed
+                child = preFlushNode(std::move(child));
 
-                    if (child->isInner())
-                    {
-                        // save our place and work on this node
-
-                        stack.emplace(std::move(node), branch);
-                        // The semantics of this changes when we move to c++-20
-                        // Right now no move will occur; With c++-20 child will
-                        // be moved from.
-                        node = std::static_pointer_cast<SHAMapInnerNode>(
-                            std::move(child));
-                        pos = 0;
-                    }
-                    else
-                    {
-                        // flush this leaf
-                        ++flushed;
+                if (child->isInner())
+                {
+                    if (levels.size() == depth + 1)
+                        levels.emplace_back();
+
+                    levels[depth + 1].push_back(
+                        {std::static_pointer_cast<SHAMapInnerNode>(
+                             std::move(child)),
+                         parent.get(),
+                         branch});
+                }
+                else
+                {
+                    // flush this leaf
+                    ++flushed;
 
-                        assert(node->cowid() == cowid_);
-                        child->updateHash();
-                        child->unshare();
+                    assert(parent->cowid() == cowid_);
+                    child->updateHash();
+                    child->unshare();
 
-                        if (doWrite)
-                            child = writeNode(t, std::move(child));
+                    if (doWrite)
+                        child = writeNode(t, std::move(child));
 
-                        node->shareChild(branch, child);
-                    }
+                    parent->shareChild(branch, child);
                 }
             }
         }
+    }
 
-        // update the hash of this inner node
-        node->updateHashDeep();
-
-        // This inner node can now be shared
-        node->unshare();
+    std::vector<std::shared_ptr<SHAMapInnerNode>> nodes;
 
-        if (doWrite)
-            node = std::static_pointer_cast<SHAMapInnerNode>(
-                writeNode(t, std::move(node)));
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level)
+    {
+        nodes.clear();
+        nodes.reserve(level->size());
+        for (auto const& dirty : *level)
+            nodes.push_back(dirty.node);
 
-        ++flushed;
+        // update the hashes of the inner nodes at this depth
+        SHAMapInnerNode::updateHashDeep(nodes);
 
-        if (stack.empty())
-            break;
+        for (auto& dirty : *level)
+        {
+            // This inner node can now be shared
+            dirty.node->unshare();
 
-        auto parent = std::move(stack.top().first);
-        pos = stack.top().second;
-        stack.pop();
+            if (doWrite)
+                dirty.node = std::static_pointer_cast<SHAMapInnerNode>(
+                    writeNode(t, std::move(dirty.node)));
 
-        // Hook this inner node to its parent
-        assert(parent->cowid() == cowid_);
-        parent->shareChild(pos, node);
+            ++flushed;
 
-        // Continue with parent's next child, if any
-        node = std::move(parent);
-        ++pos;
+            // Hook this inner node to its parent
+            if (dirty.parent)
+            {
+                assert(dirty.parent->cowid() == cowid_);
+                dirty.parent->shareChild(dirty.branch, dirty.node);
+            }
+        }
     }
 
-    // Last inner node is the new root_
-    root_ = std::move(node);
-
-    return flushed;
+    // The first inner node is the root of the flushed subtree
+    return std::move(levels.front().front().node);
 }
 
 void
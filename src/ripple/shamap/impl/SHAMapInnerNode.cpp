@@ -222,6 +222,71 @@ SHAMapInnerNode::updateHashDeep()
     updateHash();
 }
 
+void
+SHAMapInnerNode::updateHashDeep(
+    std::vector<std::shared_ptr<SHAMapInnerNode>> const& nodes)
+{
+    // The prefix followed by the hashes of all the branches
+    static constexpr std::size_t size = 4 + branchFactor * 32;
+    static constexpr std::size_t batchSize = 64;
+
+    std::uint8_t data[batchSize][size];
+    std::uint8_t const* messages[batchSize];
+    SHAMapInnerNode* hashed[batchSize];
+    uint256 digests[batchSize];
+
+    auto const prefix = boost::endian::native_to_big(
+        static_cast<std::uint32_t>(HashPrefix::innerNode));
+
+    auto it = nodes.begin();
+
+    while (it != nodes.end())
+    {
+        std::size_t count = 0;
+
+        for (; it != nodes.end() && count != batchSize; ++it)
+        {
+            auto& node = **it;
+
+            SHAMapHash* hashes;
+            std::shared_ptr<SHAMapTreeNode>* children;
+            std::tie(std::ignore, hashes, children) =
+                node.hashesAndChildren_.getHashesAndChildren();
+            node.iterNonEmptyChildIndexes([&](auto branchNum, auto indexNum) {
+                if (children[indexNum] != nullptr)
+                    hashes[indexNum] = children[indexNum]->getHash();
+            });
+
+            if (node.isBranch_ == 0)
+            {
+                node.hash_ = SHAMapHash{};
+                continue;
+            }
+
+            auto out = std::copy_n(
+                reinterpret_cast<std::uint8_t const*>(&prefix),
+                sizeof(prefix),
+                data[count]);
+            node.iterChildren([&](SHAMapHash const& hh) {
+                out = std::copy(
+                    hh.as_uint256().begin(), hh.as_uint256().end(), out);
+            });
+
+            messages[count] = data[count];
+            hashed[count] = &node;
+            ++count;
+        }
+
+        if (count == 0)
+            continue;
+
+        sha512HalfMulti(messages, size, digests, count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            hashed[i]->hash_ = SHAMapHash{digests[i]};
+    }
+}
+
 void
 SHAMapInnerNode::serializeForWire(Serializer& s) const
 {
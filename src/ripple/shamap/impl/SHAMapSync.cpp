@@ -96,6 +96,48 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
     }
 }
 
+void
+SHAMap::visitBranch(
+    int branch,
+    std::function<bool(SHAMapTreeNode&)> const& function) const
+{
+    assert((branch >= 0) && (branch < branchFactor));
+
+    if (!root_ || !root_->isInner())
+        return;
+
+    auto const root = std::static_pointer_cast<SHAMapInnerNode>(root_);
+    if (root->isEmptyBranch(branch))
+        return;
+
+    std::shared_ptr<SHAMapTreeNode> top = descendNoStore(root, branch);
+    if (!function(*top) || top->isLeaf())
+        return;
+
+    // Each entry holds an inner node being visited and the next of its
+    // branches to examine
+    using StackEntry = std::pair<int, std::shared_ptr<SHAMapInnerNode>>;
+    std::stack<StackEntry, std::vector<StackEntry>> stack;
+    stack.emplace(0, std::static_pointer_cast<SHAMapInnerNode>(top));
+
+    while (!stack.empty())
+    {
+        auto& [pos, node] = stack.top();
+        while ((pos < branchFactor) && node->isEmptyBranch(pos))
+            ++pos;
+
+        if (pos == branchFactor)
+        {
+            stack.pop();
+            continue;
+        }
+
+        std::shared_ptr<SHAMapTreeNode> child = descendNoStore(node, pos++);
+        if (function(*child) && child->isInner())
+            stack.emplace(0, std::static_pointer_cast<SHAMapInnerNode>(child));
+    }
+}
+
 void
 SHAMap::visitDifferences(
     SHAMap const* have,
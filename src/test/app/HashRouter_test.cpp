@@ -242,6 +242,45 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testShards()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s);
+
+        // The shard is selected by the first byte of the hash, so
+        // key1 and key3 share a shard, as do key2 and key4.
+        uint256 const key1(1);
+        uint256 key2(2);
+        *key2.begin() = 1;
+        uint256 const key3(3);
+        uint256 key4(4);
+        *key4.begin() = 1;
+
+        // t=0
+        router.setFlags(key1, 11111);
+        router.setFlags(key2, 22222);
+
+        ++stopwatch;
+        ++stopwatch;
+
+        // t=2
+        // Inserting key3 only expires entries from its own shard
+        router.setFlags(key3, 33333);
+        BEAST_EXPECT(router.getFlags(key2) == 22222);
+        BEAST_EXPECT(router.getFlags(key1) == 0);
+
+        ++stopwatch;
+        ++stopwatch;
+
+        // t=4
+        router.setFlags(key4, 44444);
+        BEAST_EXPECT(router.getFlags(key2) == 0);
+        BEAST_EXPECT(router.getFlags(key3) == 33333);
+        BEAST_EXPECT(router.getFlags(key4) == 44444);
+    }
+
 public:
     void
     run() override
@@ -252,6 +291,7 @@ public:
         testSetFlags();
         testRelay();
         testProcess();
+        testShards();
     }
 };
 
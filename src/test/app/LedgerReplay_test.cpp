@@ -25,6 +25,9 @@
 #include <ripple/app/ledger/impl/LedgerDeltaAcquire.h>
 #include <ripple/app/ledger/impl/LedgerReplayMsgHandler.h>
 #include <ripple/app/ledger/impl/SkipListAcquire.h>
+#include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/app/misc/HashRouter.h>
+#include <ripple/app/tx/validity.h>
 #include <ripple/basics/Slice.h>
 #include <ripple/overlay/PeerSet.h>
 #include <ripple/overlay/impl/PeerImp.h>
@@ -40,7 +43,7 @@ namespace test {
 struct LedgerReplay_test : public beast::unit_test::suite
 {
     void
-    run() override
+    testReplay()
     {
         testcase("Replay ledger");
 
@@ -67,6 +70,74 @@ struct LedgerReplay_test : public beast::unit_test::suite
 
         BEAST_EXPECT(replayed->info().hash == lastClosed->info().hash);
     }
+
+    void
+    testSignatureCheck()
+    {
+        testcase("Build ledger with parallel signature check");
+
+        using namespace jtx;
+
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+
+        Env env(*this);
+        env.fund(XRP(100000), alice, bob);
+        env.close();
+
+        // Enough transactions, none of them seen by this server yet, for
+        // buildLedger to check their signatures on several threads.
+        std::vector<std::shared_ptr<STTx const>> txs;
+        auto const aliceSeq = env.seq(alice);
+        for (std::uint32_t i = 0; i < 200; ++i)
+            txs.push_back(
+                env.jt(pay(alice, bob, XRP(1)), seq(aliceSeq + i), fee(10))
+                    .stx);
+
+        auto const parent = env.app().getLedgerMaster().getClosedLedger();
+        auto build = [&]() {
+            CanonicalTXSet txns(parent->info().hash);
+            for (auto const& tx : txs)
+                txns.insert(tx);
+
+            std::set<TxID> failed;
+            auto const built = buildLedger(
+                parent,
+                parent->info().closeTime + parent->info().closeTimeResolution,
+                true,
+                parent->info().closeTimeResolution,
+                env.app(),
+                txns,
+                failed,
+                env.journal);
+            BEAST_EXPECT(txns.empty());
+            BEAST_EXPECT(failed.empty());
+            return built;
+        };
+
+        // The first build checks the signatures in parallel. By the second,
+        // they are all cached, so it takes the serial path.
+        auto const parallel = build();
+        for (auto const& tx : txs)
+            BEAST_EXPECT(isSignatureCached(
+                env.app().getHashRouter(), tx->getTransactionID()));
+        auto const serial = build();
+
+        BEAST_EXPECT(parallel->info().txHash == serial->info().txHash);
+        BEAST_EXPECT(
+            parallel->info().accountHash == serial->info().accountHash);
+        BEAST_EXPECT(parallel->info().hash == serial->info().hash);
+        BEAST_EXPECT(
+            parallel->read(keylet::account(alice.id()))
+                ->getFieldU32(sfSequence) == aliceSeq + txs.size());
+    }
+
+    void
+    run() override
+    {
+        testReplay();
+        testSignatureCheck();
+    }
 };
 
 enum class InboundLedgersBehavior {
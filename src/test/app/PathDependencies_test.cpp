@@ -0,0 +1,282 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/paths/PathDependencies.h>
+#include <ripple/app/paths/PathRequests.h>
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/resource/Consumer.h>
+#include <test/jtx.h>
+#include <test/jtx/WSClient.h>
+
+namespace ripple {
+namespace test {
+
+class PathDependencies_test : public beast::unit_test::suite
+{
+    void
+    testChangedBy()
+    {
+        testcase("Changed by");
+
+        using namespace jtx;
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        NetClock::time_point const now{NetClock::duration{1000}};
+
+        PathDependencies deps;
+        {
+            PathDependencies::Recorder recorder(deps);
+            PathDependencies::current()->addEntry(uint256{1}, nullptr);
+            PathDependencies::current()->addRange(uint256{10}, uint256{20});
+            PathDependencies::current()->addAccount(alice.id());
+        }
+        BEAST_EXPECT(PathDependencies::current() == nullptr);
+
+        auto changedBy = [&](std::vector<uint256> keys,
+                             std::vector<AccountID> const& accounts,
+                             bool global = false) {
+            LedgerChanges changes;
+            changes.keys = std::move(keys);
+            std::sort(changes.keys.begin(), changes.keys.end());
+            changes.accounts.insert(accounts.begin(), accounts.end());
+            changes.global = global;
+            return deps.changedBy(changes, now);
+        };
+
+        BEAST_EXPECT(!changedBy({}, {}));
+        BEAST_EXPECT(!changedBy({uint256{2}, uint256{10}}, {bob.id()}));
+        BEAST_EXPECT(!changedBy({uint256{21}}, {}));
+        BEAST_EXPECT(changedBy({uint256{1}}, {}));
+        BEAST_EXPECT(changedBy({uint256{11}}, {}));
+        BEAST_EXPECT(changedBy({uint256{20}}, {}));
+        BEAST_EXPECT(changedBy({}, {bob.id(), alice.id()}));
+        BEAST_EXPECT(changedBy({}, {}, true));
+
+        // Entries which expire are only good until they do.
+        auto sle = std::make_shared<SLE>(keylet::offer(alice.id(), 1));
+        sle->setFieldU32(sfExpiration, 2000);
+        {
+            PathDependencies::Recorder recorder(deps);
+            PathDependencies::current()->addEntry(sle->key(), sle);
+        }
+        LedgerChanges const none;
+        BEAST_EXPECT(!deps.changedBy(none, now));
+        BEAST_EXPECT(deps.changedBy(none, now + std::chrono::seconds(1000)));
+    }
+
+    void
+    testLedger()
+    {
+        testcase("Ledger");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        env.fund(XRP(10000), gw, alice, bob, carol);
+        env.trust(gw["USD"](1000), alice);
+        env.close();
+
+        // Record what a search starting from alice would read.
+        PathDependencies deps;
+        auto const cache = std::make_shared<RippleLineCache>(
+            env.closed(), env.journal);
+        {
+            PathDependencies::Recorder recorder(deps);
+            cache->getLedger()->read(keylet::account(alice.id()));
+            cache->getRippleLines(alice.id(), LineDirection::outgoing);
+        }
+        BEAST_EXPECT(cache->getChanges());
+
+        auto const closeTime = [&env] {
+            return env.closed()->info().parentCloseTime;
+        };
+
+        // A payment between other accounts leaves the result alone.
+        env(pay(bob, carol, XRP(10)));
+        env.close();
+        auto changes = LedgerChanges::make(*env.closed());
+        if (!BEAST_EXPECT(changes))
+            return;
+        BEAST_EXPECT(changes->parentHash == env.closed()->info().parentHash);
+        BEAST_EXPECT(changes->accounts.count(bob.id()));
+        BEAST_EXPECT(changes->accounts.count(carol.id()));
+        BEAST_EXPECT(std::binary_search(
+            changes->keys.begin(),
+            changes->keys.end(),
+            keylet::account(bob.id()).key));
+        BEAST_EXPECT(!changes->global);
+        BEAST_EXPECT(!deps.changedBy(*changes, closeTime()));
+
+        // Issuing to alice changes her trust line.
+        env(pay(gw, alice, gw["USD"](10)));
+        env.close();
+        changes = LedgerChanges::make(*env.closed());
+        if (!BEAST_EXPECT(changes))
+            return;
+        BEAST_EXPECT(deps.changedBy(*changes, closeTime()));
+
+        // The changes of an open ledger are not known.
+        BEAST_EXPECT(!LedgerChanges::make(*env.current()));
+    }
+
+    void
+    testSubscription()
+    {
+        testcase("Subscription");
+
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const dave{"dave"};
+        Account const erin{"erin"};
+        auto const USD = gw["USD"];
+
+        // carol sells USD for XRP, which is the only way for alice to pay
+        // bob USD.
+        env.fund(XRP(10000), gw, alice, bob, carol, dave, erin);
+        env.trust(USD(1000), bob, carol);
+        env(pay(gw, carol, USD(500)));
+        env(offer(carol, XRP(100), USD(50)));
+        env.close();
+
+        Json::Value request;
+        request[jss::source_account] = alice.human();
+        request[jss::destination_account] = bob.human();
+        request[jss::destination_amount] =
+            USD(10).value().getJson(JsonOptions::none);
+        request[jss::source_currencies] = Json::arrayValue;
+        request[jss::source_currencies].append(Json::objectValue);
+        request[jss::source_currencies][0u][jss::currency] = "XRP";
+
+        auto wsc = makeWSClient(env.app().config());
+        {
+            auto create = request;
+            create[jss::subcommand] = "create";
+            auto const jv = wsc->invoke("path_find", create);
+            BEAST_EXPECT(jv[jss::result].isMember(jss::alternatives));
+        }
+
+        auto& pathRequests = env.app().getPathRequests();
+
+        // Close a ledger and return the last update the subscription got.
+        auto closeAndUpdate = [&]() {
+            env.close();
+            env.app().getJobQueue().rendezvous();
+            Json::Value update;
+            while (auto const msg = wsc->getMsg(500ms))
+            {
+                if ((*msg)[jss::type] == "path_find")
+                    update = *msg;
+            }
+            BEAST_EXPECT(update[jss::full_reply] == true);
+            return update;
+        };
+
+        // The paths a new request finds on the last validated ledger.
+        auto fresh = [&]() {
+            Resource::Consumer consumer;
+            return pathRequests.doLegacyPathRequest(
+                consumer,
+                env.app().getLedgerMaster().getValidatedLedger(),
+                request);
+        };
+
+        auto sourceAmount = [](Json::Value const& result) {
+            auto const& alternatives = result[jss::alternatives];
+            if (!alternatives.isArray() || alternatives.size() != 1)
+                return Json::Value{};
+            return alternatives[0u][jss::source_amount];
+        };
+
+        // The first full search on a closed ledger.
+        auto update = closeAndUpdate();
+        BEAST_EXPECT(sourceAmount(update) == XRP(20).value().getText());
+        BEAST_EXPECT(update[jss::alternatives] == fresh()[jss::alternatives]);
+
+        // Ledgers which change none of what the search read reuse its
+        // result, which is still what a new search finds.
+        for (int i = 0; i < 2; ++i)
+        {
+            auto const reused = pathRequests.getReusedCount();
+            env(pay(dave, erin, XRP(10)));
+            update = closeAndUpdate();
+            BEAST_EXPECT(pathRequests.getReusedCount() > reused);
+            BEAST_EXPECT(sourceAmount(update) == XRP(20).value().getText());
+            BEAST_EXPECT(
+                update[jss::alternatives] == fresh()[jss::alternatives]);
+        }
+
+        // A better offer in the book the search walked is found.
+        {
+            auto const reused = pathRequests.getReusedCount();
+            env(offer(carol, XRP(50), USD(50)));
+            update = closeAndUpdate();
+            BEAST_EXPECT(pathRequests.getReusedCount() == reused);
+            BEAST_EXPECT(sourceAmount(update) == XRP(10).value().getText());
+            BEAST_EXPECT(
+                update[jss::alternatives] == fresh()[jss::alternatives]);
+        }
+
+        // So is a change to a trust line the path uses.
+        {
+            auto const reused = pathRequests.getReusedCount();
+            env.trust(USD(2000), bob);
+            update = closeAndUpdate();
+            BEAST_EXPECT(pathRequests.getReusedCount() == reused);
+            BEAST_EXPECT(sourceAmount(update) == XRP(10).value().getText());
+            BEAST_EXPECT(
+                update[jss::alternatives] == fresh()[jss::alternatives]);
+        }
+
+        // And the search is reused again afterwards.
+        {
+            auto const reused = pathRequests.getReusedCount();
+            env(pay(dave, erin, XRP(10)));
+            update = closeAndUpdate();
+            BEAST_EXPECT(pathRequests.getReusedCount() > reused);
+            BEAST_EXPECT(
+                update[jss::alternatives] == fresh()[jss::alternatives]);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testChangedBy();
+        testLedger();
+        testSubscription();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PathDependencies, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
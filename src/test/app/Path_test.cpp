@@ -1282,6 +1282,51 @@ public:
         }
     }
 
+    void
+    parallel_ranking()
+    {
+        testcase("parallel ranking");
+        using namespace jtx;
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+
+        // Rank the candidate paths on up to the given number of threads.
+        auto findPaths = [&](int threads) {
+            Env env(*this, envconfig([threads](std::unique_ptr<Config> cfg) {
+                cfg->PATH_SEARCH_OLD = 7;
+                cfg->PATH_SEARCH = 7;
+                cfg->PATH_SEARCH_MAX = 10;
+                cfg->PATH_SEARCH_THREADS = threads;
+                return cfg;
+            }));
+            env.fund(XRP(10000), alice, bob);
+
+            // Every gateway links alice to bob, which gives the search more
+            // candidates than it needs to use several threads.
+            for (int i = 0; i < 12; ++i)
+            {
+                auto const gw = Account("gateway" + std::to_string(i));
+                env.fund(XRP(10000), gw);
+                env.trust(gw["USD"](1000), alice, bob);
+                env(pay(gw, alice, gw["USD"](10 + 5 * i)));
+            }
+            env.close();
+
+            return find_paths(env, alice, bob, bob["USD"](20));
+        };
+
+        auto const [serialPaths, serialSa, serialDa] = findPaths(1);
+        auto const [parallelPaths, parallelSa, parallelDa] = findPaths(8);
+
+        BEAST_EXPECT(!serialPaths.empty());
+        BEAST_EXPECT(
+            serialPaths.getJson(JsonOptions::none) ==
+            parallelPaths.getJson(JsonOptions::none));
+        BEAST_EXPECT(serialSa == parallelSa);
+        BEAST_EXPECT(serialDa == parallelDa);
+        BEAST_EXPECT(equal(serialDa, bob["USD"](20)));
+    }
+
     void
     noripple_combinations()
     {
@@ -1369,6 +1414,7 @@ public:
         xrp_to_xrp();
         receive_max();
         noripple_combinations();
+        parallel_ranking();
 
         // The following path_find_NN tests are data driven tests
         // that were originally implemented in js/coffee and migrated
@@ -18,10 +18,11 @@
 //==============================================================================
 
 #include <ripple/app/main/Application.h>
-#include <ripple/app/misc/SHAMapStore.h>
+#include <ripple/app/misc/SHAMapStoreImp.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/protocol/jss.h>
+#include <ripple/shamap/SHAMap.h>
 #include <test/jtx.h>
 #include <test/jtx/envconfig.h>
 
@@ -49,6 +50,16 @@ class SHAMapStore_test : public beast::unit_test::suite
         return cfg;
     }
 
+    static auto
+    incrementalDelete(std::unique_ptr<Config> cfg)
+    {
+        cfg = onlineDelete(std::move(cfg));
+        auto& section = cfg->section(ConfigSection::nodeDatabase());
+        section.set("rotation_incremental", "1");
+        section.set("rotation_threads", "4");
+        return cfg;
+    }
+
     bool
     goodLedger(
         jtx::Env& env,
@@ -518,12 +529,84 @@ public:
         lastRotated = ledgerSeq - 1;
     }
 
+    void
+    testIncremental()
+    {
+        testcase("incremental online_delete");
+        using namespace jtx;
+
+        Env env(*this, envconfig(incrementalDelete));
+        auto& store = env.app().getSHAMapStore();
+
+        auto ledgerSeq = waitForReady(env);
+        auto lastRotated = ledgerSeq - 1;
+
+        Account const alice{"alice"};
+        env.fund(XRP(10000), noripple(alice));
+        env.close();
+        ++ledgerSeq;
+        int payments = 0;
+
+        for (int rotation = 0; rotation < 2; ++rotation)
+        {
+            // Change the state in every ledger, so each pass ahead of the
+            // rotation has something new to copy
+            for (; ledgerSeq < lastRotated + deleteInterval + 1; ++ledgerSeq)
+            {
+                env(pay(env.master, alice, XRP(1)));
+                ++payments;
+                env.close();
+                store.rendezvous();
+
+                auto ledger = env.rpc("ledger", "validated");
+                BEAST_EXPECT(
+                    goodLedger(env, ledger, std::to_string(ledgerSeq), true));
+            }
+
+            store.rendezvous();
+
+            ledgerCheck(env, ledgerSeq - lastRotated, lastRotated);
+            BEAST_EXPECT(lastRotated != store.getLastRotated());
+            lastRotated = store.getLastRotated();
+            BEAST_EXPECT(env.balance(alice) == XRP(10000 + payments));
+        }
+
+        // The last rotation deleted the backend holding the state before the
+        // first copy ahead of rotation. Read the validated state back from
+        // the backends alone, and check the copies left none of it behind.
+        auto& family = env.app().getNodeFamily();
+        family.getTreeNodeCache(0)->clear();
+        family.getFullBelowCache(0)->clear();
+
+        auto const validated = env.app().getLedgerMaster().getValidatedLedger();
+        auto const& stateHash = validated->info().accountHash;
+        SHAMap state(SHAMapType::STATE, stateHash, family);
+        BEAST_EXPECT(state.fetchRoot(SHAMapHash{stateHash}, nullptr));
+
+        std::vector<SHAMapMissingNode> missing;
+        state.walkMap(missing, 32);
+        BEAST_EXPECT(missing.empty());
+
+        // The last copy only wrote the nodes which changed since the one
+        // before it
+        std::uint64_t stateNodes = 0;
+        validated->stateMap().visitNodes([&](SHAMapTreeNode&) {
+            ++stateNodes;
+            return true;
+        });
+        auto const copied =
+            dynamic_cast<SHAMapStoreImp&>(store).lastIncrementalCount();
+        BEAST_EXPECT(copied > 0);
+        BEAST_EXPECT(copied < stateNodes);
+    }
+
     void
     run() override
     {
         testClear();
         testAutomatic();
         testCanDelete();
+        testIncremental();
     }
 };
 
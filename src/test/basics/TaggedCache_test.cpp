@@ -24,6 +24,10 @@
 #include <ripple/protocol/Protocol.h>
 #include <test/unit_test/SuiteJournal.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace ripple {
 
 /*
@@ -148,6 +152,42 @@ public:
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
+
+        // Use the cache from several threads while it is being swept, and
+        // make sure the counts are consistent afterwards.
+        {
+            std::atomic<bool> failed = false;
+            std::vector<std::thread> threads;
+            for (Key t = 0; t < 4; ++t)
+            {
+                threads.emplace_back([&c, &failed, t]() {
+                    for (Key i = 0; i < 2000; ++i)
+                    {
+                        Key const key = 100 + (i * 7 + t) % 500;
+                        auto p = std::make_shared<Value>(std::to_string(key));
+                        c.canonicalize_replace_client(key, p);
+                        if (*p != std::to_string(key))
+                            failed = true;
+                        // Another thread may have deleted the key already
+                        if (auto const f = c.fetch(key);
+                            f && *f != std::to_string(key))
+                            failed = true;
+                        if (i % 3 == 0)
+                            c.del(key, false);
+                    }
+                });
+            }
+            for (int i = 0; i < 20; ++i)
+                c.sweep();
+            for (auto& thread : threads)
+                thread.join();
+            BEAST_EXPECT(!failed);
+
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
     }
 };
 
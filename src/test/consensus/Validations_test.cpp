@@ -171,6 +171,7 @@ class Validations_test : public beast::unit_test::suite
     {
         clock_type& c_;
         LedgerOracle& oracle_;
+        std::size_t acquires_ = 0;
 
     public:
         // Non-locking mutex to avoid locks in generic Validations
@@ -203,8 +204,15 @@ class Validations_test : public beast::unit_test::suite
         std::optional<Ledger>
         acquire(Ledger::ID const& id)
         {
+            ++acquires_;
             return oracle_.lookup(id);
         }
+
+        std::size_t
+        acquires() const
+        {
+            return acquires_;
+        }
     };
 
     // Specialize generic Validations using the above types
@@ -988,6 +996,49 @@ class Validations_test : public beast::unit_test::suite
             std::make_pair(ledgerABCDE.seq(), ledgerABCDE.id()));
     }
 
+    void
+    testBatchedTrieUpdates()
+    {
+        using namespace std::chrono_literals;
+        testcase("Batched trie updates");
+
+        LedgerHistoryHelper h;
+        TestHarness harness(h.oracle);
+        Node a = harness.makeNode();
+        Node b = harness.makeNode();
+        Node c = harness.makeNode();
+
+        using ID = Ledger::ID;
+        using Seq = Ledger::Seq;
+
+        // Adding trusted validations does not look up their ledgers
+        for (Node const& n : {a, b, c})
+            BEAST_EXPECT(
+                ValStatus::current ==
+                harness.add(n.validate(ID{2}, Seq{2}, 0s, 0s, true)));
+        BEAST_EXPECT(harness.vals().adaptor().acquires() == 0);
+
+        // The batch is merged with one lookup for the shared ledger, plus
+        // the check of pending acquisitions before using the trie
+        BEAST_EXPECT(
+            harness.vals().getPreferred(genesisLedger) ==
+            std::make_pair(Seq{2}, ID{2}));
+        BEAST_EXPECT(harness.vals().adaptor().acquires() == 2);
+
+        Ledger ledgerAB = h["ab"];
+        BEAST_EXPECT(harness.vals().getNodesAfter(genesisLedger, ID{0}) == 3);
+
+        // A validation that goes stale before it is merged never reaches the
+        // trie
+        harness.clock().advance(5s);
+        Ledger ledgerABC = h["abc"];
+        BEAST_EXPECT(ValStatus::current == harness.add(a.validate(ledgerABC)));
+        harness.clock().advance(harness.parms().validationCURRENT_LOCAL);
+        BEAST_EXPECT(
+            harness.vals().getPreferred(genesisLedger) == std::nullopt);
+        BEAST_EXPECT(harness.vals().getNodesAfter(genesisLedger, ID{0}) == 0);
+    }
+
     void
     testNumTrustedForLedger()
     {
@@ -1139,6 +1190,7 @@ class Validations_test : public beast::unit_test::suite
         testGetPreferredLedger();
         testGetPreferredLCL();
         testAcquireValidatedLedger();
+        testBatchedTrieUpdates();
         testNumTrustedForLedger();
         testSeqEnforcer();
         testTrustChanged();
@@ -1206,6 +1206,146 @@ struct json_value_test : beast::unit_test::suite
         BEAST_EXPECT(val.size() == 0);
     }
 
+    void
+    test_storage()
+    {
+        {
+            // References to members survive later inserts, well past the
+            // members stored inline in the object.
+            Json::Value obj{Json::objectValue};
+            Json::Value& first = obj["m000"];
+            first = "first";
+            std::vector<Json::Value*> refs;
+            for (int i = 0; i < 300; ++i)
+            {
+                auto const key = "k" + std::to_string(299 - i);
+                refs.push_back(&(obj[key] = i));
+            }
+            BEAST_EXPECT(obj.size() == 301);
+            BEAST_EXPECT(first == "first");
+            BEAST_EXPECT(&obj["m000"] == &first);
+            for (int i = 0; i < 300; ++i)
+                BEAST_EXPECT(*refs[i] == i);
+
+            // Members are visited in key order.
+            auto const names = obj.getMemberNames();
+            BEAST_EXPECT(std::is_sorted(names.begin(), names.end()));
+            std::string last;
+            for (auto it = obj.begin(); it != obj.end(); ++it)
+            {
+                BEAST_EXPECT(last < it.memberName());
+                last = it.memberName();
+            }
+
+            // Removing members releases their slots for reuse without
+            // disturbing the others.
+            for (int i = 0; i < 300; i += 2)
+                obj.removeMember("k" + std::to_string(299 - i));
+            BEAST_EXPECT(obj.size() == 151);
+            for (int i = 1; i < 300; i += 2)
+                BEAST_EXPECT(*refs[i] == i);
+            obj["z"] = "reused";
+            BEAST_EXPECT(obj.size() == 152);
+            BEAST_EXPECT(obj["z"] == "reused");
+            BEAST_EXPECT(first == "first");
+
+            Json::Value const copy = obj;
+            BEAST_EXPECT(copy == obj);
+            BEAST_EXPECT(!(copy < obj) && !(obj < copy));
+            obj.clear();
+            BEAST_EXPECT(obj.size() == 0);
+            BEAST_EXPECT(copy.size() == 152);
+            BEAST_EXPECT(copy["k298"] == 1);
+        }
+        {
+            // Arrays may be filled out of order and sparsely.
+            Json::Value arr{Json::arrayValue};
+            arr[5u] = 5;
+            arr[2u] = 2;
+            BEAST_EXPECT(arr.size() == 6);
+            BEAST_EXPECT(arr[2u] == 2);
+            BEAST_EXPECT(arr[3u].isNull());
+            BEAST_EXPECT(arr.size() == 6);
+            Json::Value& head = arr[0u];
+            for (int i = 6; i < 1000; ++i)
+                arr.append(i);
+            BEAST_EXPECT(arr.size() == 1000);
+            BEAST_EXPECT(&arr[0u] == &head);
+            BEAST_EXPECT(arr[999u] == 999);
+        }
+        {
+            // Keys arriving in descending order must not shift the whole
+            // index on every insert. Large objects keep their members in a
+            // tree, so this stays fast well past the point where a flat
+            // index would go quadratic.
+            int const count = 200000;
+            std::vector<std::string> keys;
+            keys.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                std::string key = std::to_string(i);
+                keys.push_back(std::string(6 - key.size(), '0') + key);
+            }
+
+            Json::Value obj{Json::objectValue};
+            Json::Value* const last = &(obj[keys.back()] = count - 1);
+            for (int i = count - 2; i >= 0; --i)
+                obj[keys[i]] = i;
+            BEAST_EXPECT(obj.size() == count);
+            BEAST_EXPECT(&obj[keys.back()] == last);
+
+            int expected = 0;
+            bool ordered = true;
+            for (auto it = obj.begin(); it != obj.end(); ++it, ++expected)
+                ordered = ordered && it.memberName() == keys[expected] &&
+                    *it == expected;
+            BEAST_EXPECT(ordered && expected == count);
+
+            // The same holds for a parsed object, whose keys are in
+            // whatever order the client sent them.
+            std::string text = "{";
+            for (int i = count - 1; i >= 0; --i)
+            {
+                text += "\"" + keys[i] + "\":" + std::to_string(i);
+                text += i ? "," : "}";
+            }
+            Json::Value parsed;
+            BEAST_EXPECT(Json::Reader{}.parse(text, parsed));
+            BEAST_EXPECT(parsed == obj);
+
+            // Members can be removed, and removing them all falls back to
+            // the flat index.
+            for (int i = 0; i < count; i += 2)
+                obj.removeMember(keys[i]);
+            BEAST_EXPECT(obj.size() == count / 2);
+            BEAST_EXPECT(obj[keys[1]] == 1);
+            BEAST_EXPECT(!obj.isMember(keys[0]));
+            for (int i = 1; i < count; i += 2)
+                obj.removeMember(keys[i]);
+            BEAST_EXPECT(obj.size() == 0);
+            obj["b"] = 2;
+            obj["a"] = 1;
+            BEAST_EXPECT(obj.size() == 2);
+            BEAST_EXPECT(obj.begin().memberName() == std::string("a"));
+        }
+        {
+            // Iterating a const object yields const members.
+            using Members = Json::Value::ObjectValues;
+            static_assert(std::is_same_v<
+                          decltype(*std::declval<Members const&>().begin()),
+                          Members::value_type const&>);
+            static_assert(std::is_same_v<
+                          decltype(*std::declval<Members&>().begin()),
+                          Members::value_type&>);
+            static_assert(std::is_convertible_v<
+                          Members::iterator,
+                          Members::const_iterator>);
+            static_assert(!std::is_convertible_v<
+                          Members::const_iterator,
+                          Members::iterator>);
+        }
+    }
+
     void
     test_iterator()
     {
@@ -1388,6 +1528,7 @@ struct json_value_test : beast::unit_test::suite
         test_conversions();
         test_access();
         test_removeMember();
+        test_storage();
         test_iterator();
         test_nest_limits();
         test_leak();
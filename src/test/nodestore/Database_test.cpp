@@ -21,6 +21,7 @@
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/DatabaseRotatingImp.h>
 #include <test/jtx.h>
 #include <test/jtx/CheckMessageLogs.h>
 #include <test/jtx/envconfig.h>
@@ -546,6 +547,24 @@ public:
                 fetchCopyOfBatch(*db, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
+
+            {
+                // Read it back asynchronously, in bundles
+                Batch copy;
+                asyncFetchCopyOfBatch(*db, &copy, batch);
+                BEAST_EXPECT(areBatchesEqual(batch, copy));
+            }
+
+            {
+                // Objects which were never stored are not found
+                auto const missing = createPredictableBatch(16, rng());
+                Batch copy;
+                asyncFetchCopyOfBatch(*db, &copy, missing);
+                BEAST_EXPECT(std::none_of(
+                    copy.begin(), copy.end(), [](auto const& object) {
+                        return object != nullptr;
+                    }));
+            }
         }
 
         if (testPersistence)
@@ -652,6 +671,74 @@ public:
 
     //--------------------------------------------------------------------------
 
+    void
+    testRotating(std::int64_t const seedValue)
+    {
+        testcase("NodeStore rotating database");
+
+        DummyScheduler scheduler;
+        beast::temp_dir node_db;
+
+        auto makeBackend = [&](std::string const& name) {
+            Section params;
+            params.set("type", "memory");
+            params.set("path", node_db.file(name));
+            auto backend = Manager::instance().make_Backend(
+                params, megabytes(4), scheduler, journal_);
+            backend->open();
+            return backend;
+        };
+
+        DatabaseRotatingImp db(
+            scheduler,
+            2,
+            makeBackend("first"),
+            makeBackend("second"),
+            Section{},
+            journal_);
+        auto const rotate = [&](std::string const& name) {
+            db.rotateWithLock(
+                [&](std::string const&) { return makeBackend(name); });
+        };
+
+        beast::xor_shift_engine rng(seedValue);
+        auto const archived = createPredictableBatch(numObjectsToTest, rng());
+        auto const written = createPredictableBatch(numObjectsToTest, rng());
+
+        // Move the first batch into the archive backend
+        storeBatch(db, archived);
+        rotate("third");
+        storeBatch(db, written);
+
+        {
+            // Read both backends back asynchronously, in bundles
+            Batch batch(archived);
+            batch.insert(batch.end(), written.begin(), written.end());
+            std::shuffle(batch.begin(), batch.end(), rng);
+
+            Batch copy;
+            asyncFetchCopyOfBatch(db, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+        }
+
+        {
+            // Objects read from the archive were copied to the writable
+            // backend, so they survive the next rotation
+            rotate("fourth");
+
+            Batch copy;
+            asyncFetchCopyOfBatch(db, &copy, archived);
+            BEAST_EXPECT(
+                std::all_of(
+                    copy.begin(),
+                    copy.end(),
+                    [](auto const& object) { return object != nullptr; }) &&
+                areBatchesEqual(archived, copy));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     run() override
     {
@@ -661,6 +748,8 @@ public:
 
         testNodeStore("memory", false, seedValue);
 
+        testRotating(seedValue);
+
         // Persistent backend tests
         {
             testNodeStore("nudb", true, seedValue);
@@ -29,7 +29,9 @@
 #include <ripple/nodestore/Database.h>
 #include <ripple/nodestore/Types.h>
 #include <boost/algorithm/string.hpp>
+#include <condition_variable>
 #include <iomanip>
+#include <mutex>
 
 namespace ripple {
 namespace NodeStore {
@@ -223,6 +225,35 @@ public:
                 pCopy->push_back(object);
         }
     }
+
+    // Fetch all the hashes in one batch asynchronously, into another batch.
+    // Objects which are not found are left null.
+    static void
+    asyncFetchCopyOfBatch(Database& db, Batch* pCopy, Batch const& batch)
+    {
+        pCopy->clear();
+        pCopy->resize(batch.size());
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t remaining = batch.size();
+
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            db.asyncFetch(
+                batch[i]->getHash(),
+                0,
+                [&, i](std::shared_ptr<NodeObject> const& object) {
+                    std::lock_guard lock(mutex);
+                    (*pCopy)[i] = object;
+                    if (--remaining == 0)
+                        cv.notify_one();
+                });
+        }
+
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return remaining == 0; });
+    }
 };
 
 }  // namespace NodeStore
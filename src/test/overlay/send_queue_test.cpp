@@ -0,0 +1,298 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/protocol/messages.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+namespace test {
+
+class send_queue_test : public beast::unit_test::suite
+{
+    using Lane = SendQueue::Lane;
+    using Compressed = compression::Compressed;
+
+    static std::shared_ptr<Message>
+    makeValidation()
+    {
+        protocol::TMValidation msg;
+        msg.set_validation(std::string(200, 'v'));
+        return std::make_shared<Message>(msg, protocol::mtVALIDATION);
+    }
+
+    static std::shared_ptr<Message>
+    makeTransaction(std::size_t size)
+    {
+        protocol::TMTransaction msg;
+        msg.set_rawtransaction(std::string(size, 't'));
+        msg.set_status(protocol::tsNEW);
+        return std::make_shared<Message>(msg, protocol::mtTRANSACTION);
+    }
+
+    static std::shared_ptr<Message>
+    makeLedgerData(std::size_t size)
+    {
+        protocol::TMLedgerData msg;
+        msg.set_ledgerhash(std::string(32, 'h'));
+        msg.set_ledgerseq(1);
+        msg.set_type(protocol::liAS_NODE);
+        msg.add_nodes()->set_nodedata(std::string(size, 'n'));
+        return std::make_shared<Message>(msg, protocol::mtLEDGER_DATA);
+    }
+
+    // Remembers the lane and push order of each pushed message by its
+    // buffer, so the buffers returned by next() can be traced back to their
+    // lanes and checked to come out of each lane in the order pushed.
+    struct Tracker
+    {
+        struct Pushed
+        {
+            Lane lane;
+            std::size_t seq;
+        };
+
+        SendQueue queue;
+        std::map<void const*, Pushed> pushed;
+        std::size_t nextSeq = 0;
+        std::map<Lane, std::size_t> lastTaken;
+
+        void
+        push(std::shared_ptr<Message> const& m, Lane lane)
+        {
+            pushed[m->getBuffer(Compressed::Off).data()] = {lane, nextSeq++};
+            queue.push(m);
+        }
+
+        Lane
+        laneOf(boost::asio::const_buffer const& buffer) const
+        {
+            return pushed.at(buffer.data()).lane;
+        }
+
+        // Return true if every buffer was pushed after all the buffers
+        // taken from its lane before it.
+        bool
+        inOrder(std::vector<boost::asio::const_buffer> const& buffers)
+        {
+            bool ordered = true;
+            for (auto const& buffer : buffers)
+            {
+                auto const& p = pushed.at(buffer.data());
+                auto const last = lastTaken.find(p.lane);
+                if (last != lastTaken.end() && p.seq <= last->second)
+                    ordered = false;
+                lastTaken[p.lane] = p.seq;
+            }
+            return ordered;
+        }
+    };
+
+    void
+    testLanes()
+    {
+        testcase("Lanes");
+
+        using category = TrafficCount::category;
+
+        BEAST_EXPECT(SendQueue::lane(category::validation) == Lane::consensus);
+        BEAST_EXPECT(SendQueue::lane(category::proposal) == Lane::consensus);
+        BEAST_EXPECT(
+            SendQueue::lane(category::validatorlist) == Lane::consensus);
+        BEAST_EXPECT(SendQueue::lane(category::base) == Lane::consensus);
+        BEAST_EXPECT(
+            SendQueue::lane(category::transaction) == Lane::transaction);
+        BEAST_EXPECT(
+            SendQueue::lane(category::ld_tsc_share) == Lane::transaction);
+        BEAST_EXPECT(SendQueue::lane(category::ld_asn_share) == Lane::bulk);
+        BEAST_EXPECT(SendQueue::lane(category::gl_get) == Lane::bulk);
+        BEAST_EXPECT(SendQueue::lane(category::share_fetch_pack) == Lane::bulk);
+        BEAST_EXPECT(
+            SendQueue::lane(category::replay_delta_response) == Lane::bulk);
+    }
+
+    void
+    testAccounting()
+    {
+        testcase("Accounting");
+
+        SendQueue queue;
+        BEAST_EXPECT(queue.empty());
+        BEAST_EXPECT(queue.size() == 0);
+        BEAST_EXPECT(queue.next(Compressed::Off).empty());
+        BEAST_EXPECT(!queue.writing());
+
+        queue.push(makeValidation());
+        queue.push(makeTransaction(100));
+        queue.push(makeTransaction(100));
+        queue.push(makeLedgerData(100));
+        BEAST_EXPECT(!queue.empty());
+        BEAST_EXPECT(queue.size() == 4);
+        BEAST_EXPECT(queue.depth(Lane::consensus) == 1);
+        BEAST_EXPECT(queue.depth(Lane::transaction) == 2);
+        BEAST_EXPECT(queue.depth(Lane::bulk) == 1);
+
+        auto const buffers = queue.next(Compressed::Off);
+        BEAST_EXPECT(buffers.size() == 4);
+        BEAST_EXPECT(queue.writing());
+        BEAST_EXPECT(queue.empty());
+        BEAST_EXPECT(queue.size() == 4);
+        BEAST_EXPECT(queue.depth(Lane::transaction) == 0);
+        BEAST_EXPECT(queue.peak(Lane::transaction) == 2);
+
+        BEAST_EXPECT(queue.written() == 4);
+        BEAST_EXPECT(!queue.writing());
+        BEAST_EXPECT(queue.size() == 0);
+        BEAST_EXPECT(queue.peak(Lane::consensus) == 1);
+        BEAST_EXPECT(queue.peak(Lane::bulk) == 1);
+    }
+
+    void
+    testConsensusFirst()
+    {
+        testcase("Consensus first");
+
+        Tracker t;
+        for (int i = 0; i < 20; ++i)
+            t.push(makeLedgerData(20000), Lane::bulk);
+        t.push(makeTransaction(1000), Lane::transaction);
+        t.push(makeValidation(), Lane::consensus);
+        t.push(makeValidation(), Lane::consensus);
+
+        auto const buffers = t.queue.next(Compressed::Off);
+        BEAST_EXPECT(t.inOrder(buffers));
+        BEAST_EXPECT(buffers.size() > 2);
+        BEAST_EXPECT(t.laneOf(buffers[0]) == Lane::consensus);
+        BEAST_EXPECT(t.laneOf(buffers[1]) == Lane::consensus);
+        BEAST_EXPECT(t.laneOf(buffers[2]) == Lane::transaction);
+        t.queue.written();
+
+        // A validation pushed behind a backlog of ledger data is still
+        // written first.
+        t.push(makeValidation(), Lane::consensus);
+        auto const next = t.queue.next(Compressed::Off);
+        BEAST_EXPECT(!next.empty() && t.laneOf(next[0]) == Lane::consensus);
+        t.queue.written();
+    }
+
+    void
+    testWeights()
+    {
+        testcase("Weights");
+
+        Tracker t;
+        for (int i = 0; i < 200; ++i)
+        {
+            t.push(makeTransaction(4000), Lane::transaction);
+            t.push(makeLedgerData(4000), Lane::bulk);
+        }
+
+        std::map<Lane, std::size_t> bytes;
+        while (t.queue.depth(Lane::transaction) != 0 &&
+               t.queue.depth(Lane::bulk) != 0)
+        {
+            auto const buffers = t.queue.next(Compressed::Off);
+            BEAST_EXPECT(t.inOrder(buffers));
+            std::size_t total = 0;
+            for (auto const& buffer : buffers)
+            {
+                bytes[t.laneOf(buffer)] += buffer.size();
+                total += buffer.size();
+            }
+            BEAST_EXPECT(total <= Tuning::maxWriteBytes);
+            t.queue.written();
+        }
+
+        // The transaction lane drains first, having been given three times
+        // the bandwidth of the bulk lane.
+        BEAST_EXPECT(t.queue.depth(Lane::transaction) == 0);
+        BEAST_EXPECT(t.queue.depth(Lane::bulk) != 0);
+
+        auto const ratio = static_cast<double>(bytes[Lane::transaction]) /
+            bytes[Lane::bulk];
+        log << "transaction to bulk bytes: " << ratio << std::endl;
+        BEAST_EXPECT(ratio > 2.5 && ratio < 3.5);
+
+        // The rest is bulk traffic, still in the order it was pushed.
+        while (!t.queue.empty())
+        {
+            auto const buffers = t.queue.next(Compressed::Off);
+            BEAST_EXPECT(t.inOrder(buffers));
+            for (auto const& buffer : buffers)
+                BEAST_EXPECT(t.laneOf(buffer) == Lane::bulk);
+            t.queue.written();
+        }
+    }
+
+    void
+    testLargeMessage()
+    {
+        testcase("Large message");
+
+        Tracker t;
+        auto const large = makeLedgerData(200000);
+        t.push(large, Lane::bulk);
+
+        // Keep the transaction lane busy: the large message must still go
+        // out, on its own, once the bulk lane has saved up enough credit.
+        bool sent = false;
+        for (int i = 0; i < 100 && !sent; ++i)
+        {
+            while (t.queue.depth(Lane::transaction) < 20)
+                t.push(makeTransaction(4000), Lane::transaction);
+
+            auto const buffers = t.queue.next(Compressed::Off);
+            for (auto const& buffer : buffers)
+            {
+                if (buffer.data() ==
+                    large->getBuffer(Compressed::Off).data())
+                {
+                    sent = true;
+                    BEAST_EXPECT(buffers.size() == 1);
+                }
+            }
+            t.queue.written();
+        }
+        BEAST_EXPECT(sent);
+    }
+
+public:
+    void
+    run() override
+    {
+        testLanes();
+        testAccounting();
+        testConsensusFirst();
+        testWeights();
+        testLargeMessage();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(send_queue, overlay, ripple);
+
+}  // namespace test
+
+}  // namespace ripple
@@ -20,6 +20,7 @@
 #include <ripple/beast/unit_test.h>
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/digest.h>
 #include <vector>
 
 namespace ripple {
@@ -459,12 +460,44 @@ public:
         BEAST_EXPECT(pk1 == pk3);
     }
 
+    void
+    testParsedKeyCache()
+    {
+        testcase("Parsed secp256k1 key cache");
+
+        auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
+        auto const digest = sha512Half(std::string("parsed key cache"));
+        auto const sig = signDigest(pk, sk, digest);
+
+        auto const before = getPublicKeyCacheStats();
+        BEAST_EXPECT(verifyDigest(pk, digest, sig, true));
+        auto const first = getPublicKeyCacheStats();
+        BEAST_EXPECT(first.misses == before.misses + 1);
+        BEAST_EXPECT(first.size > 0);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            BEAST_EXPECT(verifyDigest(pk, digest, sig, true));
+            BEAST_EXPECT(!verifyDigest(pk, ~digest, sig, true));
+        }
+
+        auto const after = getPublicKeyCacheStats();
+        BEAST_EXPECT(after.hits == first.hits + 20);
+        BEAST_EXPECT(after.misses == first.misses);
+
+        // A different key signing the same digest doesn't verify, even
+        // though the first key is cached.
+        auto const other = randomKeyPair(KeyType::secp256k1);
+        BEAST_EXPECT(!verifyDigest(other.first, digest, sig, true));
+    }
+
     void
     run() override
     {
         testBase58();
         testCanonical();
         testMiscOperations();
+        testParsedKeyCache();
     }
 };
 
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/Slice.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/protocol/digest.h>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+class digest_test : public beast::unit_test::suite
+{
+    // Hash messages of every size in sizes, in batches of every count in
+    // counts, and compare the results with sha512Half.
+    template <class Hash>
+    void
+    checkMulti(
+        Hash const& hash,
+        std::initializer_list<std::size_t> sizes,
+        std::initializer_list<std::size_t> counts)
+    {
+        for (std::size_t const size : sizes)
+        {
+            for (std::size_t const count : counts)
+            {
+                std::vector<Blob> data(count, Blob(size));
+                std::vector<std::uint8_t const*> messages;
+
+                for (auto& d : data)
+                {
+                    beast::rngfill(d.data(), d.size(), default_prng());
+                    messages.push_back(d.data());
+                }
+
+                std::vector<uint256> digests(count);
+                hash(messages.data(), size, digests.data(), count);
+
+                for (std::size_t i = 0; i < count; ++i)
+                    BEAST_EXPECTS(
+                        digests[i] == sha512Half(makeSlice(data[i])),
+                        "size " + std::to_string(size) + ", count " +
+                            std::to_string(count) + ", message " +
+                            std::to_string(i));
+            }
+        }
+    }
+
+    void
+    testSha512HalfMultiKernels()
+    {
+        // Sizes around the SHA-512 block and padding boundaries, and the
+        // size of a serialized inner node. Counts cover a partial first
+        // group of lanes, whole groups, and whole groups plus a partial one.
+        std::initializer_list<std::size_t> const sizes = {
+            0, 1, 8, 111, 112, 113, 127, 128, 129, 239, 240, 255, 256, 516};
+        std::initializer_list<std::size_t> const counts = {1, 2, 3, 5, 7, 8, 9, 13, 15, 16, 17, 23, 24, 31};
+
+        auto const kernels = detail::sha512HalfMultiKernels();
+        BEAST_EXPECT(!kernels.empty());
+
+        // Test every kernel this machine can run, not only the one that
+        // sha512HalfMulti picks.
+        for (auto const& kernel : kernels)
+        {
+            testcase(std::string("sha512HalfMulti kernel ") + kernel.name);
+            checkMulti(kernel.fn, sizes, counts);
+        }
+    }
+
+    void
+    testSha512HalfMulti()
+    {
+        testcase("sha512HalfMulti");
+
+        checkMulti(
+            [](auto... args) { sha512HalfMulti(args...); },
+            {0, 1, 111, 112, 127, 128, 240, 516},
+            {1, 2, 7, 8, 9, 17});
+    }
+
+public:
+    void
+    run() override
+    {
+        testSha512HalfMultiKernels();
+        testSha512HalfMulti();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(digest, protocol, ripple);
+
+}  // namespace ripple
@@ -498,6 +498,77 @@ public:
         }
     }
 
+    void
+    testLedgerTypeBinary()
+    {
+        // Binary entries of a closed ledger come straight from its state
+        // map, so check that they are filtered and paged like the JSON ones.
+        using namespace test::jtx;
+        Env env{*this, envconfig(no_admin)};
+
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        Account const bob{"bob"};
+        env.fund(XRP(100000), gw, bob);
+        env.trust(USD(1000), bob);
+        env(offer(bob, XRP(10), USD(10)));
+        env.close();
+
+        auto makeRequest = [&env](
+                               Json::StaticString const& type,
+                               bool binary,
+                               std::string const& marker = {}) {
+            Json::Value jvParams;
+            jvParams[jss::ledger_index] = "validated";
+            jvParams[jss::binary] = binary;
+            jvParams[jss::type] = type;
+            jvParams[jss::limit] = 1;
+            if (!marker.empty())
+                jvParams[jss::marker] = marker;
+            return env.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+        };
+
+        for (auto const& [type, ledgerType] :
+             {std::make_pair(jss::account, ltACCOUNT_ROOT),
+              std::make_pair(jss::offer, ltOFFER),
+              std::make_pair(jss::state, ltRIPPLE_STATE)})
+        {
+            std::vector<std::string> indexes;
+            std::string marker;
+            do
+            {
+                auto const jrr = makeRequest(type, false, marker);
+                for (auto const& j : jrr[jss::state])
+                    indexes.push_back(j[jss::index].asString());
+                marker = jrr[jss::marker].asString();
+            } while (!marker.empty());
+
+            std::vector<std::string> binaryIndexes;
+            do
+            {
+                auto const jrr = makeRequest(type, true, marker);
+                for (auto const& j : jrr[jss::state])
+                {
+                    binaryIndexes.push_back(j[jss::index].asString());
+                    auto const data = strUnHex(j[jss::data].asString());
+                    if (!BEAST_EXPECT(data))
+                        continue;
+                    uint256 index;
+                    BEAST_EXPECT(index.parseHex(j[jss::index].asString()));
+                    STLedgerEntry const sle{SerialIter{makeSlice(*data)}, index};
+                    BEAST_EXPECT(sle.getType() == ledgerType);
+                }
+                marker = jrr[jss::marker].asString();
+            } while (!marker.empty());
+
+            BEAST_EXPECT(!indexes.empty());
+            BEAST_EXPECT(indexes == binaryIndexes);
+        }
+    }
+
     void
     run() override
     {
@@ -508,6 +579,7 @@ public:
         testMarkerFollow();
         testLedgerHeader();
         testLedgerType();
+        testLedgerTypeBinary();
     }
 };
 
@@ -20,9 +20,12 @@
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/core/ConfigSections.h>
+#include <ripple/json/json_reader.h>
 #include <ripple/json/json_value.h>
+#include <ripple/net/InfoSub.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
+#include <ripple/server/WSSession.h>
 #include <test/jtx.h>
 #include <test/jtx/WSClient.h>
 #include <test/jtx/envconfig.h>
@@ -163,6 +166,131 @@ public:
         BEAST_EXPECT(jv[jss::status] == "success");
     }
 
+    void
+    testSharedLedger()
+    {
+        testcase("Ledger stream shared by clients");
+
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+
+        // Both clients are sent the same serialization of each ledger
+        std::array<std::unique_ptr<WSClient>, 2> clients{
+            makeWSClient(env.app().config()),
+            makeWSClient(env.app().config())};
+
+        Json::Value stream;
+        stream[jss::streams] = Json::arrayValue;
+        stream[jss::streams].append("ledger");
+        for (auto& wsc : clients)
+        {
+            auto const jv = wsc->invoke("subscribe", stream);
+            BEAST_EXPECT(jv[jss::result][jss::ledger_index] == 2);
+        }
+
+        env.close();
+
+        std::array<Json::Value, 2> received;
+        for (std::size_t i = 0; i < clients.size(); ++i)
+        {
+            BEAST_EXPECT(clients[i]->findMsg(5s, [&](auto const& jv) {
+                if (jv[jss::type] != "ledgerClosed")
+                    return false;
+                received[i] = jv;
+                return true;
+            }));
+        }
+        BEAST_EXPECT(received[0][jss::ledger_index] == 3);
+        BEAST_EXPECT(received[0] == received[1]);
+    }
+
+    void
+    testPublishedJson()
+    {
+        testcase("Published JSON");
+
+        auto parse = [](std::string const& text) {
+            Json::Value jv;
+            Json::Reader().parse(text, jv);
+            return jv;
+        };
+
+        {
+            // A message for several API versions is serialized once for
+            // each of them.
+            MultiApiJson multi{Json::Value(Json::objectValue)};
+            for (auto v = RPC::apiMinimumSupportedVersion.value;
+                 v <= RPC::apiMaximumValidVersion.value;
+                 ++v)
+                multi.val[MultiApiJson::index(v)][jss::api_version] = v;
+
+            PublishedJson const message{multi};
+            for (auto v = RPC::apiMinimumSupportedVersion.value;
+                 v <= RPC::apiMaximumValidVersion.value;
+                 ++v)
+            {
+                auto const& text = message.text(v);
+                BEAST_EXPECT(text);
+                BEAST_EXPECT(message.text(v).get() == text.get());
+                BEAST_EXPECT(
+                    parse(*text) == multi.val[MultiApiJson::index(v)]);
+                BEAST_EXPECT(
+                    &message.json(v) == &multi.val[MultiApiJson::index(v)]);
+            }
+
+            auto const first = message.text(RPC::apiMinimumSupportedVersion);
+            auto const last = message.text(RPC::apiMaximumValidVersion);
+            BEAST_EXPECT(first.get() != last.get());
+            BEAST_EXPECT(*first != *last);
+        }
+
+        {
+            // A message which is the same for every API version is
+            // serialized once.
+            Json::Value jv(Json::objectValue);
+            jv[jss::type] = "ledgerClosed";
+            jv[jss::ledger_index] = 3;
+
+            PublishedJson const message{jv};
+            auto const text = message.text(RPC::apiMinimumSupportedVersion);
+            BEAST_EXPECT(
+                message.text(RPC::apiMaximumValidVersion).get() == text.get());
+            BEAST_EXPECT(&message.json(RPC::apiMaximumValidVersion) == &jv);
+            BEAST_EXPECT(parse(*text) == jv);
+
+            // Every session writes from the same bytes, however it splits
+            // them up.
+            SharedWSMsg whole{text};
+            SharedWSMsg pieces{text};
+
+            auto const [wholeDone, wholeBuffers] =
+                whole.prepare(text->size(), [] {});
+            BEAST_EXPECT(wholeDone == true);
+            BEAST_EXPECT(wholeBuffers.size() == 1);
+            BEAST_EXPECT(wholeBuffers[0].data() == text->data());
+            BEAST_EXPECT(wholeBuffers[0].size() == text->size());
+
+            std::string written;
+            for (std::size_t i = 0; i <= text->size(); ++i)
+            {
+                auto const [done, buffers] = pieces.prepare(5, [] {});
+                for (auto const& buffer : buffers)
+                {
+                    BEAST_EXPECT(
+                        static_cast<char const*>(buffer.data()) ==
+                        text->data() + written.size());
+                    written.append(
+                        static_cast<char const*>(buffer.data()),
+                        buffer.size());
+                }
+                if (done)
+                    break;
+            }
+            BEAST_EXPECT(written == *text);
+        }
+    }
+
     void
     testTransactions_APIv1()
     {
@@ -1302,6 +1430,8 @@ public:
 
         testServer();
         testLedger();
+        testSharedLedger();
+        testPublishedJson();
         testTransactions_APIv1();
         testTransactions_APIv2();
         testManifests();
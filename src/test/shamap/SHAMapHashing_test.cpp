@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/shamap/SHAMap.h>
+#include <chrono>
+#include <sstream>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+namespace tests {
+
+namespace {
+
+boost::intrusive_ptr<SHAMapItem>
+makeRandomItem(beast::xor_shift_engine& r)
+{
+    Serializer s;
+    for (int d = 0; d < 8; ++d)
+        s.add32(rand_int<std::uint32_t>(r));
+    return make_shamapitem(s.getSHA512Half(), s.slice());
+}
+
+void
+addRandomItems(std::size_t n, SHAMap& map, beast::xor_shift_engine& r)
+{
+    while (n--)
+        map.addItem(SHAMapNodeType::tnACCOUNT_STATE, makeRandomItem(r));
+}
+
+}  // namespace
+
+// Verifies that the parallel flush produces exactly the same map as the
+// serial one.
+class SHAMapHashing_test : public beast::unit_test::suite
+{
+    void
+    testFlush(bool backed, std::size_t items, beast::Journal const& journal)
+    {
+        testcase(
+            std::string("parallel flush ") +
+            (backed ? "backed " : "unbacked ") + std::to_string(items));
+
+        TestNodeFamily f(journal);
+
+        SHAMap serial(SHAMapType::STATE, f);
+        SHAMap parallel(SHAMapType::STATE, f);
+        if (!backed)
+        {
+            serial.setUnbacked();
+            parallel.setUnbacked();
+        }
+
+        beast::xor_shift_engine r1(items);
+        beast::xor_shift_engine r2(items);
+        addRandomItems(items, serial, r1);
+        addRandomItems(items, parallel, r2);
+
+        int const serialFlushed = serial.flushDirty(hotACCOUNT_NODE);
+        int const parallelFlushed = parallel.flushDirty(hotACCOUNT_NODE, true);
+        BEAST_EXPECT(serialFlushed == parallelFlushed);
+        BEAST_EXPECT(serial.getHash() == parallel.getHash());
+        BEAST_EXPECT(serial.deepCompare(parallel));
+        parallel.invariants();
+
+        // Nothing is left to flush
+        BEAST_EXPECT(parallel.flushDirty(hotACCOUNT_NODE, true) == 0);
+
+        // Modify mutable snapshots so that only part of the map is dirty
+        auto serialCopy = serial.snapShot(true);
+        auto parallelCopy = parallel.snapShot(true);
+        addRandomItems(items / 10 + 1, *serialCopy, r1);
+        addRandomItems(items / 10 + 1, *parallelCopy, r2);
+
+        BEAST_EXPECT(serialCopy->unshare() == parallelCopy->unshare(true));
+        BEAST_EXPECT(serialCopy->getHash() == parallelCopy->getHash());
+        BEAST_EXPECT(serialCopy->getHash() != serial.getHash());
+        parallelCopy->invariants();
+
+        // The snapshots were taken from already flushed maps
+        BEAST_EXPECT(serial.getHash() == parallel.getHash());
+    }
+
+public:
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMapHashing_test", *this);
+
+        for (bool const backed : {true, false})
+        {
+            testFlush(backed, 1, journal);
+            testFlush(backed, 17, journal);
+            testFlush(backed, 5000, journal);
+        }
+    }
+};
+
+// Compares the time taken to hash a large account state map serially and
+// in parallel.
+class SHAMapHashingBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    std::size_t const items_ = 1000000;
+
+    template <class Function>
+    std::chrono::milliseconds
+    timed(Function&& f)
+    {
+        auto const start = clock_type::now();
+        f();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            clock_type::now() - start);
+    }
+
+    void
+    benchmark(bool doWrite, beast::Journal const& journal)
+    {
+        testcase(
+            std::string(doWrite ? "flushDirty " : "unshare ") +
+            std::to_string(items_) + " leaves");
+
+        TestNodeFamily f(journal);
+
+        SHAMap serial(SHAMapType::STATE, f);
+        SHAMap parallel(SHAMapType::STATE, f);
+        if (!doWrite)
+        {
+            serial.setUnbacked();
+            parallel.setUnbacked();
+        }
+
+        beast::xor_shift_engine r1(items_);
+        beast::xor_shift_engine r2(items_);
+        addRandomItems(items_, serial, r1);
+        addRandomItems(items_, parallel, r2);
+
+        auto const serialTime = timed([&] {
+            if (doWrite)
+                serial.flushDirty(hotACCOUNT_NODE);
+            else
+                serial.unshare();
+        });
+
+        auto const parallelTime = timed([&] {
+            if (doWrite)
+                parallel.flushDirty(hotACCOUNT_NODE, true);
+            else
+                parallel.unshare(true);
+        });
+
+        BEAST_EXPECT(serial.getHash() == parallel.getHash());
+
+        std::stringstream ss;
+        ss << "serial " << serialTime.count() << "ms, parallel "
+           << parallelTime.count() << "ms";
+        log << ss.str() << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMapHashingBench_test", *this);
+
+        benchmark(false, journal);
+        benchmark(true, journal);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SHAMapHashing, ripple_app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMapHashingBench, ripple_app, ripple);
+
+}  // namespace tests
+}  // namespace ripple
@@ -112,6 +112,33 @@ public:
         source.visitLeaves([&count](auto const& item) { ++count; });
         BEAST_EXPECT(count == items);
 
+        {
+            // Visiting each branch of the root reaches every node except the
+            // root
+            std::size_t nodes = 0;
+            source.visitNodes([&nodes](SHAMapTreeNode&) {
+                ++nodes;
+                return true;
+            });
+
+            std::size_t visited = 0;
+            for (int branch = 0; branch < 16; ++branch)
+                source.visitBranch(branch, [&visited](SHAMapTreeNode&) {
+                    ++visited;
+                    return true;
+                });
+            BEAST_EXPECT(visited + 1 == nodes);
+
+            // Declining to enter inner nodes skips their subtrees
+            visited = 0;
+            for (int branch = 0; branch < 16; ++branch)
+                source.visitBranch(branch, [&visited](SHAMapTreeNode&) {
+                    ++visited;
+                    return false;
+                });
+            BEAST_EXPECT(visited == 16);
+        }
+
         std::vector<SHAMapMissingNode> missingNodes;
         source.walkMap(missingNodes, 2048);
         BEAST_EXPECT(missingNodes.empty());